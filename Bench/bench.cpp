@@ -0,0 +1,311 @@
+//@file bench.cpp
+//@brief Headless accuracy/throughput benchmark of the disparity kernel
+//@date 18 October 2026
+//
+// Runs every disparity mode over the stereo pairs in Image/disparity for a
+// grid of block sizes and disparity ranges and prints one record per run:
+//    - throughput in megapixels*disparities per second (best of N repeats);
+//    - peak scratch memory one thread of the kernel held in the run (each run
+//      gets a fresh context, so the value is not carried over from earlier
+//      runs; with N threads the total may be up to N times larger);
+//    - share of pixels marked unreliable by the kernel;
+//    - bad-pixel percentage against ground truth, when <name>_gt.png exists.
+//
+// Usage: bench [--format csv|json] [--output file] [--images dir]
+//              [--repeat N] [--gt-scale S]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+extern "C"
+{
+#include "Lib/Kernels/ref.h"
+#include "Lib/Common/types.h"
+}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace
+{
+   const char* const Datasets[] = { "cones", "toys" };
+   const uint32_t    BlockSizes[] = { 5, 9, 15, 21 };
+   const int16_t     MaxDisparities[] = { 16, 32, 64, 96 };
+
+   ///@brief Disparity mode: the kernel parameters that change the algorithm
+   struct DisparityMode
+   {
+      const char* name;
+      uint32_t    uniquenessThreshold;
+   };
+
+   const DisparityMode Modes[] = {
+      { "plain",  0 },  // winner-takes-all, no uniqueness check
+      { "unique", 15 }, // uniqueness check as in the demo
+   };
+
+   ///@brief Benchmark settings taken from the command line
+   struct Options
+   {
+      std::string format = "csv";
+      std::string output;
+      std::string images = "../Image/disparity/";
+      int         repeat = 3;
+      double      gtScale = 4.0; // Middlebury 8-bit ground truth is scaled by 4
+   };
+
+   ///@brief One benchmark record
+   struct Result
+   {
+      std::string dataset;
+      std::string mode;
+      uint32_t    width;
+      uint32_t    height;
+      uint32_t    blockSize;
+      int16_t     maxDisparity;
+      double      seconds;
+      double      mpixDispPerSec;
+      double      scratchPeakPerThreadMB;
+      double      unreliablePercent;
+      double      badPixelPercent; // negative if there is no ground truth
+   };
+
+   ///@brief Parses command line, returns false on unknown arguments
+   bool ParseOptions(int argc, char* argv[], Options& o_options)
+   {
+      for (int i = 1; i < argc; ++i)
+      {
+         const std::string arg = argv[i];
+         const bool hasValue = i + 1 < argc;
+
+         if (arg == "--format" && hasValue)
+            o_options.format = argv[++i];
+         else if (arg == "--output" && hasValue)
+            o_options.output = argv[++i];
+         else if (arg == "--images" && hasValue)
+            o_options.images = argv[++i];
+         else if (arg == "--repeat" && hasValue)
+            o_options.repeat = std::max(1, atoi(argv[++i]));
+         else if (arg == "--gt-scale" && hasValue)
+            o_options.gtScale = atof(argv[++i]);
+         else
+            return false;
+      }
+      return o_options.format == "csv" || o_options.format == "json";
+   }
+
+   ///@brief Compares computed disparity with ground truth inside the region
+   ///       where the kernel produces values.
+   void Evaluate(const cv::Mat& i_disparity, const cv::Mat& i_groundTruth, double i_gtScale,
+                 uint32_t i_blockSize, int16_t i_maxDisparity, Result& io_result)
+   {
+      const int halfsize = int(i_blockSize / 2);
+      const int x0 = std::max(int(i_maxDisparity), halfsize);
+
+      size_t total = 0;
+      size_t unreliable = 0;
+      size_t withGt = 0;
+      size_t bad = 0;
+
+      for (int y = halfsize; y < i_disparity.rows - halfsize; ++y)
+      {
+         for (int x = x0; x < i_disparity.cols - halfsize; ++x)
+         {
+            const int16_t d = i_disparity.at<int16_t>(y, x);
+            ++total;
+            if (d < 0)
+               ++unreliable;
+
+            if (i_groundTruth.empty())
+               continue;
+
+            const uint8_t gt = i_groundTruth.at<uint8_t>(y, x);
+            if (gt == 0) // unknown disparity
+               continue;
+
+            ++withGt;
+            if (d < 0 || std::fabs(double(d) - double(gt) / i_gtScale) > 1.0)
+               ++bad;
+         }
+      }
+
+      io_result.unreliablePercent = total ? 100.0 * double(unreliable) / double(total) : 0.0;
+      io_result.badPixelPercent = withGt ? 100.0 * double(bad) / double(withGt) : -1.0;
+   }
+
+   ///@brief Runs one configuration, returns false if the kernel failed
+   bool RunCase(const cv::Mat& i_left, const cv::Mat& i_right, const cv::Mat& i_groundTruth,
+                const Options& i_options, Result& io_result, uint32_t i_uniquenessThreshold)
+   {
+      const uint32_t width = uint32_t(i_left.cols);
+      const uint32_t height = uint32_t(i_left.rows);
+
+      _vx_image leftVXImage = { i_left.data, width, height, VX_DF_IMAGE_U8, VX_COLOR_SPACE_DEFAULT };
+      _vx_image rightVXImage = { i_right.data, width, height, VX_DF_IMAGE_U8, VX_COLOR_SPACE_DEFAULT };
+
+      cv::Mat disparity(i_left.rows, i_left.cols, CV_16SC1, cv::Scalar(0));
+      _vx_image disparityVXImage = { disparity.data, width, height, VX_DF_IMAGE_S16, VX_COLOR_SPACE_DEFAULT };
+
+      // the scratch high-water mark lives as long as the context, so every
+      // configuration measures its own
+      vx_context context = vxCreateContext();
+      if (!context)
+         return false;
+
+      double best = 0.0;
+      for (int r = 0; r < i_options.repeat; ++r)
+      {
+         const auto start = std::chrono::steady_clock::now();
+         const vx_status status = ref_DisparityMap(
+            &leftVXImage, &rightVXImage, &disparityVXImage,
+            io_result.blockSize, io_result.maxDisparity, i_uniquenessThreshold);
+         const auto stop = std::chrono::steady_clock::now();
+
+         if (status != VX_SUCCESS)
+         {
+            vxReleaseContext(&context);
+            return false;
+         }
+
+         const double seconds = std::chrono::duration<double>(stop - start).count();
+         best = (r == 0) ? seconds : std::min(best, seconds);
+      }
+
+      io_result.width = width;
+      io_result.height = height;
+      io_result.seconds = best;
+      io_result.mpixDispPerSec = best > 0.0
+         ? double(width) * double(height) * double(io_result.maxDisparity + 1) / best / 1e6
+         : 0.0;
+      vx_size scratchPeak = 0;
+      vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_SCRATCH_HIGH_WATER_EXT, &scratchPeak, sizeof(scratchPeak));
+      io_result.scratchPeakPerThreadMB = double(scratchPeak) / (1024.0 * 1024.0);
+      vxReleaseContext(&context);
+
+      Evaluate(disparity, i_groundTruth, i_options.gtScale, io_result.blockSize, io_result.maxDisparity, io_result);
+      return true;
+   }
+
+   ///@brief Prints results as CSV
+   void PrintCsv(FILE* o_file, const std::vector<Result>& i_results)
+   {
+      fprintf(o_file, "dataset,mode,width,height,block_size,max_disparity,seconds,"
+                      "mpix_disp_per_sec,scratch_peak_per_thread_mb,unreliable_pct,bad_pixel_pct\n");
+      for (const auto& r : i_results)
+      {
+         fprintf(o_file, "%s,%s,%u,%u,%u,%d,%.6f,%.3f,%.1f,%.2f,",
+                 r.dataset.c_str(), r.mode.c_str(), r.width, r.height, r.blockSize, int(r.maxDisparity),
+                 r.seconds, r.mpixDispPerSec, r.scratchPeakPerThreadMB, r.unreliablePercent);
+         if (r.badPixelPercent >= 0.0)
+            fprintf(o_file, "%.2f\n", r.badPixelPercent);
+         else
+            fprintf(o_file, "\n");
+      }
+   }
+
+   ///@brief Prints results as JSON array
+   void PrintJson(FILE* o_file, const std::vector<Result>& i_results)
+   {
+      fprintf(o_file, "[\n");
+      for (size_t i = 0; i < i_results.size(); ++i)
+      {
+         const Result& r = i_results[i];
+         fprintf(o_file, "  {\"dataset\": \"%s\", \"mode\": \"%s\", \"width\": %u, \"height\": %u, "
+                         "\"block_size\": %u, \"max_disparity\": %d, \"seconds\": %.6f, "
+                         "\"mpix_disp_per_sec\": %.3f, \"scratch_peak_per_thread_mb\": %.1f, \"unreliable_pct\": %.2f, ",
+                 r.dataset.c_str(), r.mode.c_str(), r.width, r.height, r.blockSize, int(r.maxDisparity),
+                 r.seconds, r.mpixDispPerSec, r.scratchPeakPerThreadMB, r.unreliablePercent);
+         if (r.badPixelPercent >= 0.0)
+            fprintf(o_file, "\"bad_pixel_pct\": %.2f}", r.badPixelPercent);
+         else
+            fprintf(o_file, "\"bad_pixel_pct\": null}");
+         fprintf(o_file, i + 1 < i_results.size() ? ",\n" : "\n");
+      }
+      fprintf(o_file, "]\n");
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+   Options options;
+   if (!ParseOptions(argc, argv, options))
+   {
+      fprintf(stderr, "Usage: bench [--format csv|json] [--output file] [--images dir] "
+                      "[--repeat N] [--gt-scale S]\n");
+      return 2;
+   }
+
+   std::vector<Result> results;
+   bool failed = false;
+
+   for (const char* dataset : Datasets)
+   {
+      const std::string prefix = options.images + dataset;
+      const cv::Mat left = cv::imread(prefix + "_left.png", CV_LOAD_IMAGE_GRAYSCALE);
+      const cv::Mat right = cv::imread(prefix + "_right.png", CV_LOAD_IMAGE_GRAYSCALE);
+      const cv::Mat groundTruth = cv::imread(prefix + "_gt.png", CV_LOAD_IMAGE_GRAYSCALE);
+
+      if (left.empty() || right.empty() || left.size() != right.size() ||
+          (!groundTruth.empty() && groundTruth.size() != left.size()))
+      {
+         fprintf(stderr, "ERROR: unable to load stereo pair '%s'\n", prefix.c_str());
+         failed = true;
+         continue;
+      }
+
+      for (const DisparityMode& mode : Modes)
+      {
+         for (uint32_t blockSize : BlockSizes)
+         {
+            for (int16_t maxDisparity : MaxDisparities)
+            {
+               if (int(maxDisparity) + int(blockSize) >= left.cols || blockSize >= uint32_t(left.rows))
+                  continue;
+
+               Result result = Result();
+               result.dataset = dataset;
+               result.mode = mode.name;
+               result.blockSize = blockSize;
+               result.maxDisparity = maxDisparity;
+
+               if (!RunCase(left, right, groundTruth, options, result, mode.uniquenessThreshold))
+               {
+                  fprintf(stderr, "ERROR: %s/%s block %u disparity %d failed\n",
+                          dataset, mode.name, blockSize, int(maxDisparity));
+                  failed = true;
+                  continue;
+               }
+               results.push_back(result);
+            }
+         }
+      }
+   }
+
+   FILE* out = stdout;
+   if (!options.output.empty())
+   {
+      out = fopen(options.output.c_str(), "w");
+      if (!out)
+      {
+         fprintf(stderr, "ERROR: unable to open '%s'\n", options.output.c_str());
+         return 1;
+      }
+   }
+
+   if (options.format == "json")
+      PrintJson(out, results);
+   else
+      PrintCsv(out, results);
+
+   if (out != stdout)
+      fclose(out);
+
+   return failed ? 1 : 0;
+}
@@ -11,6 +11,7 @@ extern "C"
 {
 #include "Lib/Kernels/ref.h"
 #include "Lib/Common/types.h"
+#include "Lib/Common/vx_ext.h"
 }
 
 #include "../DemoEngine.h"
@@ -61,6 +62,18 @@ namespace
 	const std::string DisparityMapWindowName = "My Disparity Map";
 	const std::string ControlsWindowName = "Controls";
 	const std::string CVDisparityMapWindowName = "OpevCV Disparity Map";
+
+	///@brief wraps single-channel cv::Mat into vx_image without copying
+	vx_image CreateVXImage(vx_context context, const cv::Mat& image, vx_df_image format)
+	{
+		vx_imagepatch_addressing_t addr = VX_IMAGEPATCH_ADDR_INIT;
+		addr.dim_x = image.cols;
+		addr.dim_y = image.rows;
+		addr.stride_x = vx_int32(image.elemSize());
+		addr.stride_y = vx_int32(image.step);
+		void* ptr = image.data;
+		return vxCreateImageFromHandle(context, format, &addr, &ptr, VX_IMPORT_TYPE_HOST);
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -105,36 +118,21 @@ void demo_DisparityMap::applyParameters(int, void* pointer)
 	const cv::Size size(pThis->m_leftImage.cols, pThis->m_rightImage.rows);
 
 	///@{ OPENVX
-	_vx_image leftVXImage = {
-		pThis->m_leftImage.data,
-		size.width,
-		size.height,
-		VX_DF_IMAGE_U8,
-		VX_COLOR_SPACE_DEFAULT
-	};
-
-	_vx_image rightVXImage = {
-		pThis->m_rightImage.data,
-		size.width,
-		size.height,
-		VX_DF_IMAGE_U8,
-		VX_COLOR_SPACE_DEFAULT
-	};
-
-	int16_t* disparityImageData = (int16_t*)(calloc(size.width * size.height, sizeof(int16_t)));
-	_vx_image disparityVXImage = {
-		disparityImageData,
-		size.width,
-		size.height,
-		VX_DF_IMAGE_S16,
-		VX_COLOR_SPACE_DEFAULT
-	};
+	vx_context context = vxCreateContext();
+	const cv::Mat disparityMap16Bits(size, CV_16SC1, cv::Scalar(0));
+	vx_image leftVXImage = CreateVXImage(context, pThis->m_leftImage, VX_DF_IMAGE_U8);
+	vx_image rightVXImage = CreateVXImage(context, pThis->m_rightImage, VX_DF_IMAGE_U8);
+	vx_image disparityVXImage = CreateVXImage(context, disparityMap16Bits, VX_DF_IMAGE_S16);
 
 	ref_DisparityMap(
-		&leftVXImage, &rightVXImage, &disparityVXImage, 
+		leftVXImage, rightVXImage, disparityVXImage, 
 		pThis->m_blockHalfsize * 2 + 1, (int16_t)pThis->m_numDisparities, (uint32_t)pThis->m_uniquenessThreshold);
 
-	const cv::Mat disparityMap16Bits = cv::Mat(size, CV_16SC1, disparityImageData);
+	vxReleaseImage(&leftVXImage);
+	vxReleaseImage(&rightVXImage);
+	vxReleaseImage(&disparityVXImage);
+	vxReleaseContext(&context);
+
 	cv::Mat       disparityMap8Bits;
 
 	double minVal, maxVal;
@@ -145,8 +143,6 @@ void demo_DisparityMap::applyParameters(int, void* pointer)
 		disparityMap16Bits.convertTo(disparityMap8Bits, CV_8UC1, 255 / (maxVal - minVal));
 		cv::imshow(DisparityMapWindowName, disparityMap8Bits);
 	}
-	
-	free(disparityImageData);
 
 	///@}
 
@@ -11,6 +11,7 @@ extern "C"
 {
 #include "Lib/Kernels/ref.h"
 #include "Lib/Common/types.h"
+#include "Lib/Common/vx_ext.h"
 }
 
 #include "../DemoEngine.h"
@@ -52,6 +53,18 @@ namespace
    const std::string m_openCVWindow    = "openCV";
    const std::string m_originalWindow  = "original";
    const std::string m_diffWindow      = m_openVXWindow + "-" + m_openCVWindow;
+
+   ///@brief wraps 8-bit cv::Mat into vx_image without copying
+   vx_image CreateVXImage(vx_context context, const cv::Mat& image)
+   {
+      vx_imagepatch_addressing_t addr = VX_IMAGEPATCH_ADDR_INIT;
+      addr.dim_x = image.cols;
+      addr.dim_y = image.rows;
+      addr.stride_x = 1;
+      addr.stride_y = vx_int32(image.step);
+      void* ptr = image.data;
+      return vxCreateImageFromHandle(context, VX_DF_IMAGE_U8, &addr, &ptr, VX_IMPORT_TYPE_HOST);
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -87,26 +100,17 @@ void demo_Threshold::applyParameters(int, void* data)
 
    ///@{ OPENVX
    _vx_threshold vxThresh = { VX_THRESHOLD_TYPE_BINARY, uint8_t(demo->m_threshold), 0/* dummy value */, 255 /* dummy value */};
-   _vx_image srcVXImage = {
-      demo->m_srcImage.data,
-      imgSize.width,
-      imgSize.height,
-      VX_DF_IMAGE_U8,
-      VX_COLOR_SPACE_DEFAULT
-   };
-
-   uint8_t* outVXImage = static_cast<uint8_t*>(calloc(imgSize.width* imgSize.height, sizeof(uint8_t)));
-   _vx_image dstVXImage = {
-      outVXImage,
-      imgSize.width,
-      imgSize.height,
-      VX_DF_IMAGE_U8,
-      VX_COLOR_SPACE_DEFAULT
-   };
-
-   ref_Threshold(&srcVXImage, &dstVXImage, &vxThresh);
-
-   const cv::Mat vxImage = cv::Mat(imgSize, CV_8UC1, outVXImage);
+   vx_context context = vxCreateContext();
+   const cv::Mat vxImage(imgSize, CV_8UC1);
+   vx_image srcVXImage = CreateVXImage(context, demo->m_srcImage);
+   vx_image dstVXImage = CreateVXImage(context, vxImage);
+
+   ref_Threshold(srcVXImage, dstVXImage, &vxThresh);
+
+   vxReleaseImage(&srcVXImage);
+   vxReleaseImage(&dstVXImage);
+   vxReleaseContext(&context);
+
    cv::imshow(m_openVXWindow, vxImage);
    ///@}
 
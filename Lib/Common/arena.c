@@ -0,0 +1,149 @@
+/*
+    File: arena.c
+    Содержит реализацию стекового распределителя памяти.
+
+    Date: 18 Октября 2026
+*/
+
+#include "arena.h"
+#include "platform.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Smallest chunk, so that a few tiny requests do not allocate several chunks
+#define ARENA_MIN_CHUNK (64 * 1024)
+
+// The header occupies a whole alignment unit, so chunk data stays aligned
+#define ARENA_HEADER OWN_ARENA_ALIGNMENT
+
+struct _own_arena_chunk
+{
+    own_arena_chunk* prev;
+    size_t base;        // position of the first byte in the arena
+    size_t capacity;
+};
+
+static uint8_t* ChunkData(own_arena_chunk* chunk)
+{
+    return (uint8_t*)chunk + ARENA_HEADER;
+}
+
+static size_t AlignSize(size_t size)
+{
+    return (size + OWN_ARENA_ALIGNMENT - 1) / OWN_ARENA_ALIGNMENT * OWN_ARENA_ALIGNMENT;
+}
+
+static own_arena_chunk* CreateChunk(own_arena_chunk* prev, size_t capacity)
+{
+    if (capacity > SIZE_MAX - ARENA_HEADER)
+        return NULL;
+
+    own_arena_chunk* chunk = (own_arena_chunk*)ownAlignedAlloc(ARENA_HEADER + capacity, OWN_ARENA_ALIGNMENT);
+    if (!chunk)
+        return NULL;
+
+    chunk->prev = prev;
+    chunk->base = prev ? prev->base + prev->capacity : 0;
+    chunk->capacity = capacity;
+    return chunk;
+}
+
+own_arena ownCreateArena(size_t reserve)
+{
+    own_arena arena = (own_arena)calloc(1, sizeof(struct _own_arena));
+    if (!arena)
+        return NULL;
+
+    arena->reserve = AlignSize(reserve > ARENA_MIN_CHUNK ? reserve : ARENA_MIN_CHUNK);
+    return arena;
+}
+
+void ownReleaseArena(own_arena* arena)
+{
+    if (!arena || !*arena)
+        return;
+
+    own_arena_chunk* chunk = (*arena)->chunk;
+    while (chunk)
+    {
+        own_arena_chunk* prev = chunk->prev;
+        ownAlignedFree(chunk);
+        chunk = prev;
+    }
+
+    free(*arena);
+    *arena = NULL;
+}
+
+size_t ownArenaMark(own_arena arena)
+{
+    return arena && arena->chunk ? arena->chunk->base + arena->offset : 0;
+}
+
+void* ownArenaAlloc(own_arena arena, size_t size)
+{
+    if (!arena || size > SIZE_MAX - OWN_ARENA_ALIGNMENT)
+        return NULL;
+
+    size = AlignSize(size ? size : 1);
+
+    own_arena_chunk* chunk = arena->chunk;
+    if (!chunk || chunk->capacity - arena->offset < size)
+    {
+        // grow geometrically; the tail of the current chunk stays unused
+        size_t capacity = chunk ? 2 * chunk->capacity : arena->reserve;
+        if (capacity < size)
+            capacity = size;
+
+        chunk = CreateChunk(chunk, capacity);
+        if (!chunk)
+            return NULL;
+        arena->chunk = chunk;
+        arena->offset = 0;
+    }
+
+    void* ptr = ChunkData(chunk) + arena->offset;
+    arena->offset += size;
+
+    const size_t used = chunk->base + arena->offset;
+    if (used > arena->high_water)
+        arena->high_water = used;
+
+    return ptr;
+}
+
+void* ownArenaCalloc(own_arena arena, size_t count, size_t size)
+{
+    if (size && count > SIZE_MAX / size)
+        return NULL;
+
+    void* ptr = ownArenaAlloc(arena, count * size);
+    if (ptr)
+        memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void ownArenaReset(own_arena arena, size_t mark)
+{
+    if (!arena || !arena->chunk)
+        return;
+
+    own_arena_chunk* chunk = arena->chunk;
+    while (chunk->prev && chunk->base > mark)
+    {
+        own_arena_chunk* prev = chunk->prev;
+        ownAlignedFree(chunk);
+        chunk = prev;
+    }
+
+    // the arena is empty: replace an outgrown chunk with one that holds the whole peak
+    if (mark == 0 && chunk->capacity < arena->high_water)
+    {
+        ownAlignedFree(chunk);
+        chunk = CreateChunk(NULL, AlignSize(arena->high_water));
+    }
+
+    arena->chunk = chunk;
+    arena->offset = chunk ? mark - chunk->base : 0;
+}
@@ -0,0 +1,96 @@
+/*
+    File: arena.h
+    Содержит стековый распределитель памяти для временных данных функций.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Constant: OWN_ARENA_ALIGNMENT
+    Выравнивание блоков, выделяемых из арены, в байтах.
+*/
+#define OWN_ARENA_ALIGNMENT 64
+
+/*
+    Type: own_arena_chunk
+    Непрерывный участок памяти арены.
+*/
+typedef struct _own_arena_chunk own_arena_chunk;
+
+/*
+    Structure: _own_arena
+    Арена: память выделяется последовательно и освобождается только
+    откатом к отметке <ownArenaMark>. Если за вызов памяти не хватило, арена
+    наращивается новыми участками, а при полном откате заменяет их одним
+    участком размером с максимальное заполнение, так что в установившемся
+    режиме функции не обращаются к куче.
+*/
+typedef struct _own_arena
+{
+    //Variable: chunk
+    //текущий участок (участки связаны в стек);
+    own_arena_chunk* chunk;
+    //Variable: offset
+    //занятая часть текущего участка в байтах;
+    size_t offset;
+    //Variable: high_water
+    //максимальный объём памяти, занятый одновременно;
+    size_t high_water;
+    //Variable: reserve
+    //минимальный размер участка в байтах;
+    size_t reserve;
+    //Variable: next
+    //следующая арена в списке арен контекста;
+    struct _own_arena* next;
+    //Variable: in_use
+    //1, если арена закреплена за потоком.
+    uint32_t in_use;
+} *own_arena;
+
+/*
+    Function: ownCreateArena
+    Создаёт арену с участком размером reserve байт (память для участка
+    выделяется при первом запросе).
+*/
+own_arena ownCreateArena(size_t reserve);
+
+/*
+    Function: ownReleaseArena
+    Освобождает арену и всю её память.
+*/
+void ownReleaseArena(own_arena* arena);
+
+/*
+    Function: ownArenaMark
+    Возвращает отметку текущего заполнения арены для <ownArenaReset>.
+*/
+size_t ownArenaMark(own_arena arena);
+
+/*
+    Function: ownArenaAlloc
+    Выделяет size байт, выровненных на <OWN_ARENA_ALIGNMENT>.
+
+    Return:
+        Указатель на память или NULL, если памяти не хватило (или arena
+        равна NULL).
+*/
+void* ownArenaAlloc(own_arena arena, size_t size);
+
+/*
+    Function: ownArenaCalloc
+    Выделяет обнулённый массив из count элементов размером size байт.
+*/
+void* ownArenaCalloc(own_arena arena, size_t count, size_t size);
+
+/*
+    Function: ownArenaReset
+    Освобождает всю память, выделенную после получения отметки mark.
+*/
+void ownArenaReset(own_arena arena, size_t mark);
+
+#endif // __ARENA_H__
@@ -0,0 +1,440 @@
+/*
+    File: array.c
+    Содержит реализацию функций массива OpenVX.
+
+    Date: 18 Октября 2026
+*/
+
+#include "types.h"
+#include "vx_ext.h"
+#include "platform.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Memory is allocated for a multiple of this many items, so every field of
+// a structure-of-arrays layout starts on a 64-byte boundary
+#define GRANULE 16
+#define ALIGNMENT 64
+
+// Size of the fields of structures that may be stored field by field
+#define FIELD_SIZE 4
+
+struct _own_array_access
+{
+    // the pointer handed out by vxAccessArrayRange
+    void* ptr;
+    vx_size start;
+    vx_size end;
+    vx_size stride;
+    vx_enum usage;
+    // ptr points into the array itself, so nothing is written back
+    uint32_t direct;
+    // ptr is a buffer of the library holding a copy of the items
+    uint32_t owned;
+    struct _own_array_access* next;
+};
+
+static vx_size GetItemSize(vx_enum type)
+{
+    switch (type)
+    {
+    case VX_TYPE_CHAR:          return sizeof(vx_char);
+    case VX_TYPE_INT8:          return sizeof(vx_int8);
+    case VX_TYPE_UINT8:         return sizeof(vx_uint8);
+    case VX_TYPE_INT16:         return sizeof(vx_int16);
+    case VX_TYPE_UINT16:        return sizeof(vx_uint16);
+    case VX_TYPE_INT32:         return sizeof(vx_int32);
+    case VX_TYPE_UINT32:        return sizeof(vx_uint32);
+    case VX_TYPE_INT64:         return sizeof(vx_int64);
+    case VX_TYPE_UINT64:        return sizeof(vx_uint64);
+    case VX_TYPE_FLOAT32:       return sizeof(vx_float32);
+    case VX_TYPE_FLOAT64:       return sizeof(vx_float64);
+    case VX_TYPE_ENUM:          return sizeof(vx_enum);
+    case VX_TYPE_SIZE:          return sizeof(vx_size);
+    case VX_TYPE_DF_IMAGE:      return sizeof(vx_df_image);
+    case VX_TYPE_BOOL:          return sizeof(vx_bool);
+    case VX_TYPE_RECTANGLE:     return sizeof(vx_rectangle_t);
+    case VX_TYPE_KEYPOINT:      return sizeof(vx_keypoint_t);
+    case VX_TYPE_COORDINATES2D: return sizeof(vx_coordinates2d_t);
+    case VX_TYPE_COORDINATES3D: return sizeof(vx_coordinates3d_t);
+    default:                    return 0;
+    }
+}
+
+// The structures made of 4-byte fields only
+static bool HasFields(vx_enum type)
+{
+    return type == VX_TYPE_RECTANGLE || type == VX_TYPE_KEYPOINT ||
+        type == VX_TYPE_COORDINATES2D || type == VX_TYPE_COORDINATES3D;
+}
+
+static uint8_t* GetField(const vx_array arr, vx_size field)
+{
+    return (uint8_t*)arr->data + field * arr->allocated * FIELD_SIZE;
+}
+
+// Copies count items from start on into dst, stride bytes apart
+static void ReadItems(const vx_array arr, vx_size start, vx_size count, uint8_t* dst, vx_size stride)
+{
+    if (arr->layout == VX_ARRAY_LAYOUT_SOA_EXT)
+    {
+        for (vx_size f = 0; f < arr->item_size / FIELD_SIZE; f++)
+        {
+            const uint8_t* src = GetField(arr, f) + start * FIELD_SIZE;
+            for (vx_size i = 0; i < count; i++)
+                memcpy(dst + i * stride + f * FIELD_SIZE, src + i * FIELD_SIZE, FIELD_SIZE);
+        }
+        return;
+    }
+
+    const uint8_t* src = (const uint8_t*)arr->data + start * arr->item_size;
+    if (stride == arr->item_size)
+    {
+        memcpy(dst, src, count * stride);
+        return;
+    }
+    for (vx_size i = 0; i < count; i++)
+        memcpy(dst + i * stride, src + i * arr->item_size, arr->item_size);
+}
+
+// Copies count items, stride bytes apart, into the array from start on
+static void WriteItems(vx_array arr, vx_size start, vx_size count, const uint8_t* src, vx_size stride)
+{
+    if (arr->layout == VX_ARRAY_LAYOUT_SOA_EXT)
+    {
+        for (vx_size f = 0; f < arr->item_size / FIELD_SIZE; f++)
+        {
+            uint8_t* dst = GetField(arr, f) + start * FIELD_SIZE;
+            for (vx_size i = 0; i < count; i++)
+                memcpy(dst + i * FIELD_SIZE, src + i * stride + f * FIELD_SIZE, FIELD_SIZE);
+        }
+        return;
+    }
+
+    uint8_t* dst = (uint8_t*)arr->data + start * arr->item_size;
+    if (stride == arr->item_size)
+    {
+        memcpy(dst, src, count * stride);
+        return;
+    }
+    for (vx_size i = 0; i < count; i++)
+        memcpy(dst + i * arr->item_size, src + i * stride, arr->item_size);
+}
+
+// Moves the items into new memory for allocated items in the given layout
+static vx_status Relayout(vx_array arr, vx_size allocated, vx_enum layout)
+{
+    if (allocated > SIZE_MAX / arr->item_size)
+        return VX_ERROR_NO_MEMORY;
+
+    struct _vx_array target = *arr;
+    target.data = ownAlignedAlloc(allocated * arr->item_size, ALIGNMENT);
+    target.allocated = allocated;
+    target.layout = layout;
+    if (!target.data)
+        return VX_ERROR_NO_MEMORY;
+
+    if (arr->num_items != 0)
+    {
+        if (arr->layout == VX_ARRAY_LAYOUT_AOS_EXT)
+        {
+            WriteItems(&target, 0, arr->num_items, (const uint8_t*)arr->data, arr->item_size);
+        }
+        else if (layout == VX_ARRAY_LAYOUT_AOS_EXT)
+        {
+            ReadItems(arr, 0, arr->num_items, (uint8_t*)target.data, arr->item_size);
+        }
+        else
+        {
+            for (vx_size f = 0; f < arr->item_size / FIELD_SIZE; f++)
+                memcpy(GetField(&target, f), GetField(arr, f), arr->num_items * FIELD_SIZE);
+        }
+    }
+
+    ownAlignedFree(arr->data);
+    arr->data = target.data;
+    arr->allocated = allocated;
+    arr->layout = layout;
+    return VX_SUCCESS;
+}
+
+// Doubles the memory until count items fit, so appending is amortized O(1)
+static vx_status Reserve(vx_array arr, vx_size count)
+{
+    if (count <= arr->allocated)
+        return VX_SUCCESS;
+
+    vx_size allocated = arr->allocated > SIZE_MAX / 2 ? count : arr->allocated * 2;
+    if (allocated < count)
+        allocated = count;
+    if (arr->capacity != 0 && allocated > arr->capacity)
+        allocated = arr->capacity;
+    if (allocated > SIZE_MAX - GRANULE)
+        return VX_ERROR_NO_MEMORY;
+    allocated = (allocated + GRANULE - 1) / GRANULE * GRANULE;
+
+    return Relayout(arr, allocated, arr->layout);
+}
+
+static bool IsUsage(vx_enum usage)
+{
+    return usage == VX_READ_ONLY || usage == VX_WRITE_ONLY || usage == VX_READ_AND_WRITE;
+}
+
+// A capacity of 0 leaves the array unbounded: it grows as items are added
+VX_API_ENTRY vx_array VX_API_CALL vxCreateArray(vx_context context, vx_enum item_type, vx_size capacity)
+{
+    const vx_size item_size = GetItemSize(item_type);
+    if (!context || item_size == 0)
+        return NULL;
+
+    vx_array arr = (vx_array)calloc(1, sizeof(struct _vx_array));
+    if (!arr)
+        return NULL;
+
+    arr->data = NULL;
+    arr->num_items = 0;
+    arr->capacity = capacity;
+    arr->allocated = 0;
+    arr->item_size = item_size;
+    arr->array_type = item_type;
+    arr->layout = VX_ARRAY_LAYOUT_AOS_EXT;
+    arr->accesses = NULL;
+    return arr;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseArray(vx_array *arr)
+{
+    if (!arr || !*arr)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    vx_array a = *arr;
+    while (a->accesses)
+    {
+        struct _own_array_access* next = a->accesses->next;
+        if (a->accesses->owned)
+            free(a->accesses->ptr);
+        free(a->accesses);
+        a->accesses = next;
+    }
+    ownAlignedFree(a->data);
+    free(a);
+
+    *arr = NULL;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryArray(vx_array arr, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!arr)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_ARRAY_ATTRIBUTE_ITEMTYPE:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = arr->array_type;
+        return VX_SUCCESS;
+
+    case VX_ARRAY_ATTRIBUTE_NUMITEMS:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = arr->num_items;
+        return VX_SUCCESS;
+
+    case VX_ARRAY_ATTRIBUTE_CAPACITY:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = arr->capacity;
+        return VX_SUCCESS;
+
+    case VX_ARRAY_ATTRIBUTE_ITEMSIZE:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = arr->item_size;
+        return VX_SUCCESS;
+
+    case VX_ARRAY_ATTRIBUTE_LAYOUT_EXT:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = arr->layout;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetArrayAttributeExt(vx_array arr, vx_enum attribute, const void *ptr, vx_size size)
+{
+    if (!arr)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_ARRAY_ATTRIBUTE_LAYOUT_EXT:
+    {
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        const vx_enum layout = *(const vx_enum*)ptr;
+        if (layout != VX_ARRAY_LAYOUT_AOS_EXT && (layout != VX_ARRAY_LAYOUT_SOA_EXT || !HasFields(arr->array_type)))
+            return VX_ERROR_NOT_SUPPORTED;
+        if (layout == arr->layout)
+            return VX_SUCCESS;
+
+        // the items of an open access would move under the application
+        if (arr->accesses)
+            return VX_FAILURE;
+
+        if (!arr->data)
+        {
+            arr->layout = layout;
+            return VX_SUCCESS;
+        }
+        return Relayout(arr, arr->allocated, layout);
+    }
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxAddArrayItems(vx_array arr, vx_size count, const void *ptr, vx_size stride)
+{
+    if (!arr)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (count == 0)
+        return VX_SUCCESS;
+    if (!ptr || stride < arr->item_size)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    if (arr->capacity != 0 ? count > arr->capacity - arr->num_items : count > SIZE_MAX - arr->num_items)
+        return VX_FAILURE;
+
+    // growing moves the items away from the pointer of an open access
+    if (arr->num_items + count > arr->allocated && arr->accesses)
+        return VX_FAILURE;
+
+    const vx_status status = Reserve(arr, arr->num_items + count);
+    if (status != VX_SUCCESS)
+        return status;
+
+    WriteItems(arr, arr->num_items, count, (const uint8_t*)ptr, stride);
+    arr->num_items += count;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxTruncateArray(vx_array arr, vx_size new_num_items)
+{
+    if (!arr)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (new_num_items > arr->num_items)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    // an open access could no longer be committed
+    if (arr->accesses)
+        return VX_FAILURE;
+
+    arr->num_items = new_num_items;
+    return VX_SUCCESS;
+}
+
+/*
+    Items stored one after another are accessed in place. Items stored field
+    by field are gathered into a buffer of the library, which the commit
+    scatters back unless the access was read-only.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxAccessArrayRange(vx_array arr, vx_size start, vx_size end, vx_size *stride, void **ptr, vx_enum usage)
+{
+    if (!arr)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!stride || !ptr || start >= end || end > arr->num_items || !IsUsage(usage))
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (*ptr && *stride < arr->item_size)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    struct _own_array_access* access = (struct _own_array_access*)calloc(1, sizeof(struct _own_array_access));
+    if (!access)
+        return VX_ERROR_NO_MEMORY;
+
+    const vx_size count = end - start;
+    if (*ptr)
+    {
+        if (usage != VX_WRITE_ONLY)
+            ReadItems(arr, start, count, (uint8_t*)*ptr, *stride);
+    }
+    else if (arr->layout == VX_ARRAY_LAYOUT_AOS_EXT)
+    {
+        *ptr = (uint8_t*)arr->data + start * arr->item_size;
+        *stride = arr->item_size;
+        access->direct = 1;
+    }
+    else
+    {
+        *ptr = malloc(count * arr->item_size);
+        if (!*ptr)
+        {
+            free(access);
+            return VX_ERROR_NO_MEMORY;
+        }
+        *stride = arr->item_size;
+        access->owned = 1;
+        if (usage != VX_WRITE_ONLY)
+            ReadItems(arr, start, count, (uint8_t*)*ptr, *stride);
+    }
+
+    access->ptr = *ptr;
+    access->start = start;
+    access->end = end;
+    access->stride = *stride;
+    access->usage = usage;
+    access->next = arr->accesses;
+    arr->accesses = access;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxCommitArrayRange(vx_array arr, vx_size start, vx_size end, const void *ptr)
+{
+    if (!arr)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    struct _own_array_access** link = &arr->accesses;
+    while (*link && ((*link)->ptr != ptr || (*link)->start != start || (*link)->end != end))
+        link = &(*link)->next;
+
+    struct _own_array_access* access = *link;
+    if (!access || end > arr->num_items)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    if (access->usage != VX_READ_ONLY && !access->direct)
+        WriteItems(arr, start, end - start, (const uint8_t*)ptr, access->stride);
+
+    *link = access->next;
+    if (access->owned)
+        free(access->ptr);
+    free(access);
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxAccessArrayFieldExt(vx_array arr, vx_uint32 field, void **ptr)
+{
+    if (!arr)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr || arr->layout != VX_ARRAY_LAYOUT_SOA_EXT || field >= arr->item_size / FIELD_SIZE)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    // an empty array gets its first granule, so the pointer is never NULL
+    const vx_status status = Reserve(arr, 1);
+    if (status != VX_SUCCESS)
+        return status;
+
+    *ptr = GetField(arr, field);
+    return VX_SUCCESS;
+}
@@ -0,0 +1,202 @@
+/*
+    File: border.c
+    Содержит обработку границы изображения для функций, которые читают
+    окрестность пикселя.
+
+    Date: 18 Октября 2026
+*/
+
+#include "border.h"
+#include "image.h"
+#include "context.h"
+#include "parallel.h"
+
+#include <string.h>
+
+const void* ownGetBorderRow(const vx_image image, int32_t y, const vx_border_mode_t* border, const void* constant_row, void* buffer)
+{
+    if (y < 0 || y >= (int32_t)image->height)
+    {
+        if (border->mode == VX_BORDER_MODE_CONSTANT)
+            return constant_row;
+        if (border->mode != VX_BORDER_MODE_REPLICATE)
+            return NULL;
+        y = y < 0 ? 0 : (int32_t)image->height - 1;
+    }
+    return ownLoadRow(image, (uint32_t)y, buffer);
+}
+
+typedef struct
+{
+    vx_image src_image;
+    vx_image dst_image;
+    uint32_t radius;
+    vx_border_mode_t border;
+    own_window_row_f func;
+    const void* params;
+    volatile int32_t out_of_memory;
+} WindowArgs;
+
+static void FillConstant(uint8_t* dst, uint32_t count, uint32_t pixel_size, uint32_t value)
+{
+    uint8_t pixel[sizeof(uint32_t)];
+    switch (pixel_size)
+    {
+    case 1: { const uint8_t v = (uint8_t)value; memcpy(pixel, &v, sizeof(v)); break; }
+    case 2: { const uint16_t v = (uint16_t)value; memcpy(pixel, &v, sizeof(v)); break; }
+    default: memcpy(pixel, &value, sizeof(value)); break;
+    }
+
+    for (uint32_t x = 0; x < count; x++)
+        memcpy(dst + (size_t)x * pixel_size, pixel, pixel_size);
+}
+
+/*
+    Builds the window rows of the columns [x_begin, x_end) in edge buffers:
+    each buffer holds the columns [x_begin - radius, x_end + radius) with the
+    columns outside the image filled by the border mode. The span is at most
+    3 * radius pixels wide, so the per-pixel checks here stay off the interior.
+*/
+static void BuildEdgeWindow(const WindowArgs* args, const uint8_t* const* rows, uint32_t x_begin, uint32_t x_end,
+                            uint8_t* edge, const void** window)
+{
+    const uint32_t width = args->src_image->width;
+    const uint32_t radius = args->radius;
+    const uint32_t pixel_size = ownGetPixelSize(args->src_image->image_type);
+    const size_t edge_size = 3 * (size_t)radius * pixel_size;
+    const int32_t span_begin = (int32_t)x_begin - (int32_t)radius;
+    const int32_t span_end = (int32_t)x_end + (int32_t)radius;
+
+    for (uint32_t i = 0; i < 2 * radius + 1; i++)
+    {
+        uint8_t* dst = edge + i * edge_size;
+
+        for (int32_t x = span_begin; x < span_end; x++)
+        {
+            uint8_t* pixel = dst + (size_t)(x - span_begin) * pixel_size;
+            if (x >= 0 && x < (int32_t)width)
+                memcpy(pixel, rows[i] + (size_t)x * pixel_size, pixel_size);
+            else if (args->border.mode == VX_BORDER_MODE_REPLICATE)
+                memcpy(pixel, rows[i] + (x < 0 ? 0 : (size_t)(width - 1) * pixel_size), pixel_size);
+            else
+                FillConstant(pixel, 1, pixel_size, args->border.constant_value);
+        }
+
+        window[i] = dst + (size_t)radius * pixel_size;
+    }
+}
+
+static void WindowRows(void* data, uint32_t y_begin, uint32_t y_end)
+{
+    WindowArgs* args = (WindowArgs*)data;
+    const vx_image src_image = args->src_image;
+    const vx_image dst_image = args->dst_image;
+    const uint32_t width = src_image->width;
+    const uint32_t height = src_image->height;
+    const uint32_t radius = args->radius;
+    const uint32_t num_rows = 2 * radius + 1;
+    const uint32_t pixel_size = ownGetPixelSize(src_image->image_type);
+    const uint32_t dst_pixel_size = ownGetPixelSize(dst_image->image_type);
+    const size_t row_size = (size_t)width * pixel_size;
+    const bool undefined = args->border.mode == VX_BORDER_MODE_UNDEFINED;
+
+    own_arena arena = ownGetScratchArena();
+    const size_t arena_mark = ownArenaMark(arena);
+
+    const uint8_t** rows = (const uint8_t**)ownArenaAlloc(arena, num_rows * sizeof(*rows));
+    const void** window = (const void**)ownArenaAlloc(arena, num_rows * sizeof(*window));
+    uint8_t* edge = undefined ? NULL : (uint8_t*)ownArenaAlloc(arena, num_rows * 3 * (size_t)radius * pixel_size + 1);
+    uint8_t* constant_row = args->border.mode == VX_BORDER_MODE_CONSTANT ? (uint8_t*)ownArenaAlloc(arena, row_size) : NULL;
+    // rows with gaps between pixels are gathered into row buffers
+    uint8_t* src_buffers = ownIsRowDense(src_image) ? NULL : (uint8_t*)ownArenaAlloc(arena, num_rows * row_size);
+    uint8_t* dst_buffer = ownIsRowDense(dst_image) ? NULL : (uint8_t*)ownArenaAlloc(arena, (size_t)width * dst_pixel_size);
+
+    if (!rows || !window || (!undefined && !edge) || (args->border.mode == VX_BORDER_MODE_CONSTANT && !constant_row) ||
+        (!ownIsRowDense(src_image) && !src_buffers) || (!ownIsRowDense(dst_image) && !dst_buffer))
+    {
+        ownArenaReset(arena, arena_mark);
+        args->out_of_memory = 1;
+        return;
+    }
+
+    if (constant_row)
+        FillConstant(constant_row, width, pixel_size, args->border.constant_value);
+
+    for (uint32_t y = y_begin; y < y_end; y++)
+    {
+        if (undefined && (y < radius || y + radius >= height))
+            continue;
+
+        for (uint32_t i = 0; i < num_rows; i++)
+        {
+            rows[i] = (const uint8_t*)ownGetBorderRow(src_image, (int32_t)y - (int32_t)radius + (int32_t)i, &args->border,
+                                                      constant_row, src_buffers ? src_buffers + i * row_size : NULL);
+        }
+
+        uint8_t* dst = (uint8_t*)ownGetRowOutput(dst_image, y, dst_buffer);
+        // the border columns are left as they are, so a gathered row starts from the image
+        if (undefined && dst == dst_buffer)
+            ownLoadRow(dst_image, y, dst_buffer);
+
+        // interior: every window lies inside the image
+        if (width > 2 * radius)
+        {
+            for (uint32_t i = 0; i < num_rows; i++)
+                window[i] = rows[i] + (size_t)radius * pixel_size;
+            args->func(window, dst + (size_t)radius * dst_pixel_size, width - 2 * radius, args->params);
+        }
+
+        if (!undefined)
+        {
+            const uint32_t left_end = radius < width ? radius : width;
+            if (left_end > 0)
+            {
+                BuildEdgeWindow(args, rows, 0, left_end, edge, window);
+                args->func(window, dst, left_end, args->params);
+            }
+
+            const uint32_t right_begin = width > 2 * radius ? width - radius : radius;
+            if (right_begin < width)
+            {
+                BuildEdgeWindow(args, rows, right_begin, width, edge, window);
+                args->func(window, dst + (size_t)right_begin * dst_pixel_size, width - right_begin, args->params);
+            }
+        }
+
+        ownStoreRow(dst_image, y, dst);
+    }
+
+    ownArenaReset(arena, arena_mark);
+}
+
+vx_status ownMapWindow(const vx_image src_image, vx_image dst_image, uint32_t radius, const vx_border_mode_t* border, own_window_row_f func, const void* params)
+{
+    if (src_image->width != dst_image->width || src_image->height != dst_image->height)
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (!ownCheckStrides(src_image) || !ownCheckStrides(dst_image))
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (ownGetPixelSize(src_image->image_type) == 0 || ownGetPixelSize(dst_image->image_type) == 0 ||
+        src_image->image_type == VX_DF_IMAGE_U1_EXT || dst_image->image_type == VX_DF_IMAGE_U1_EXT)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    if (border->mode != VX_BORDER_MODE_UNDEFINED && border->mode != VX_BORDER_MODE_CONSTANT &&
+        border->mode != VX_BORDER_MODE_REPLICATE)
+        return VX_ERROR_NOT_SUPPORTED;
+
+    if (src_image->width == 0 || src_image->height == 0)
+        return VX_SUCCESS;
+
+    WindowArgs args;
+    args.src_image = src_image;
+    args.dst_image = dst_image;
+    args.radius = radius;
+    args.border = *border;
+    args.func = func;
+    args.params = params;
+    args.out_of_memory = 0;
+
+    const size_t row_bytes = ownGetRowSize(src_image->image_type, src_image->width) +
+                             ownGetRowSize(dst_image->image_type, dst_image->width);
+    ownParallelFor(dst_image->height, row_bytes, WindowRows, &args);
+    return args.out_of_memory ? VX_ERROR_NO_MEMORY : VX_SUCCESS;
+}
@@ -0,0 +1,68 @@
+/*
+    File: border.h
+    Содержит обработку границы изображения для функций, которые читают
+    окрестность пикселя.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __BORDER_H__
+#define __BORDER_H__
+
+#include "types.h"
+
+/*
+    Function: ownGetBorderRow
+    Возвращает непрерывную строку y изображения, где y может выходить за
+    пределы изображения. За границей для VX_BORDER_MODE_REPLICATE берётся
+    ближайшая строка изображения, для VX_BORDER_MODE_CONSTANT - constant_row,
+    для VX_BORDER_MODE_UNDEFINED возвращается NULL.
+
+    Parameters:
+        image        - изображение;
+        y            - номер строки;
+        border       - режим границы;
+        constant_row - строка, заполненная border->constant_value (только для
+                       VX_BORDER_MODE_CONSTANT);
+        buffer       - буфер строки для <ownLoadRow>.
+*/
+const void* ownGetBorderRow(const vx_image image, int32_t y, const vx_border_mode_t* border, const void* constant_row, void* buffer);
+
+/*
+    Type: own_window_row_f
+    Обработка count пикселей строки по окну радиуса radius: rows[i] указывает
+    на первый обрабатываемый пиксель в строке i - radius относительно
+    текущей, функция читает rows[i][k - radius] ... rows[i][k + radius] для
+    k из [0, count). dst - непрерывная строка выходного изображения.
+*/
+typedef void (*own_window_row_f)(const void* const* rows, void* dst, uint32_t count, const void* params);
+
+/*
+    Function: ownMapWindow
+    Применяет func к окнам (2 * radius + 1) x (2 * radius + 1) всех
+    пикселей изображения на пуле потоков контекста.
+
+    Внутренняя часть строки передаётся func одним вызовом прямо по строкам
+    изображения, поэтому функция окна не проверяет границу. Крайние radius
+    столбцов с каждой стороны обрабатываются отдельными вызовами по
+    небольшим буферам, дополненным по режиму границы. Для
+    VX_BORDER_MODE_UNDEFINED пиксели, окно которых выходит за изображение, не
+    изменяются.
+
+    Parameters:
+        src_image - входное изображение;
+        dst_image - выходное изображение того же размера;
+        radius    - радиус окна;
+        border    - режим границы;
+        func      - функция обработки строки;
+        params    - параметры функции.
+
+    Return:
+        VX_SUCCESS                  - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - размеры изображений не совпадают, шаги
+                                      недопустимы или формат не поддерживается;
+        VX_ERROR_NOT_SUPPORTED      - неизвестный режим границы;
+        VX_ERROR_NO_MEMORY          - не удалось выделить временные буферы.
+*/
+vx_status ownMapWindow(const vx_image src_image, vx_image dst_image, uint32_t radius, const vx_border_mode_t* border, own_window_row_f func, const void* params);
+
+#endif // __BORDER_H__
@@ -0,0 +1,411 @@
+/*
+    File: context.c
+    Содержит реализацию функций контекста OpenVX.
+
+    Date: 18 Октября 2026
+*/
+
+#include "context.h"
+#include "graph.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define IMPLEMENTATION_NAME "openvx_ext"
+
+// Sizes the arenas for typical frames from the start
+#define DEFAULT_SCRATCH_SIZE (1024 * 1024)
+
+static vx_context g_context = NULL;
+static volatile int32_t g_context_lock = 0;
+static uint32_t g_context_id = 0;
+
+// The arena of the current thread; the context id tells a stale arena of a
+// destroyed context from a live one
+static OWN_THREAD_LOCAL own_arena t_arena = NULL;
+static OWN_THREAD_LOCAL vx_context t_arena_context = NULL;
+static OWN_THREAD_LOCAL uint32_t t_arena_context_id = 0;
+
+// Threads outside the pool are not told to give their arena and log ring
+// back, so the key's destructor does it when they exit (see ownWatchThreadExit)
+static own_tls_key g_exit_key;
+static bool g_exit_key_ready = false;
+
+static void OWN_TLS_CALLBACK ReleaseThreadObjects(void* value)
+{
+    (void)value;
+    // the lock keeps the context alive; objects of a destroyed one are gone
+    ownSpinLock(&g_context_lock);
+    ownReleaseScratchArena(g_context);
+    ownReleaseLogRing(g_context);
+    ownSpinUnlock(&g_context_lock);
+}
+
+static vx_context CreateContext(void)
+{
+    // called under g_context_lock, so the key is created once
+    if (!g_exit_key_ready)
+        g_exit_key_ready = ownCreateTlsKey(&g_exit_key, ReleaseThreadObjects);
+
+    vx_context context = (vx_context)calloc(1, sizeof(struct _vx_context));
+    if (!context)
+        return NULL;
+
+    context->ref_count = 0;
+    context->num_threads = ownGetNumCpus();
+    context->pool = NULL;
+    context->pool_lock = 0;
+    context->pool_users = 0;
+    context->image_border = 0;
+    context->immediate_border.mode = VX_BORDER_MODE_UNDEFINED;
+    context->immediate_border.constant_value = 0;
+    context->id = ++g_context_id;
+    context->arenas = NULL;
+    context->scratch_size = DEFAULT_SCRATCH_SIZE;
+    context->arena_lock = 0;
+    context->log_callback = NULL;
+    context->log_enabled = 0;
+    context->log_rings = NULL;
+    context->log_lock = 0;
+    context->log_draining = 0;
+    context->delays = NULL;
+    context->delay_lock = 0;
+    context->target = VX_TARGET_ANY_EXT;
+    context->kernels = NULL;
+    context->kernel_lock = 0;
+    return context;
+}
+
+static void DestroyContext(vx_context context)
+{
+    // workers give their arenas and log rings back on exit, so the pool goes first
+    ownReleaseThreadPool(&context->pool);
+    ownReleaseLog(context);
+    ownReleaseKernels(context);
+
+    while (context->arenas)
+    {
+        own_arena next = context->arenas->next;
+        ownReleaseArena(&context->arenas);
+        context->arenas = next;
+    }
+
+    free(context);
+}
+
+vx_context ownGetContext(void)
+{
+    vx_context context = g_context;
+    if (context)
+        return context;
+
+    ownSpinLock(&g_context_lock);
+    if (!g_context)
+        g_context = CreateContext();
+    context = g_context;
+    ownSpinUnlock(&g_context_lock);
+
+    return context;
+}
+
+own_thread_pool ownAcquireThreadPool(vx_context context)
+{
+    if (!context)
+        return NULL;
+
+    ownSpinLock(&context->pool_lock);
+    if (!context->pool && context->num_threads > 1)
+        context->pool = ownCreateThreadPool(context->num_threads - 1);
+    own_thread_pool pool = context->pool;
+    if (pool)
+        context->pool_users++;
+    ownSpinUnlock(&context->pool_lock);
+
+    return pool;
+}
+
+void ownDropThreadPool(vx_context context, own_thread_pool pool)
+{
+    if (!pool)
+        return;
+
+    ownSpinLock(&context->pool_lock);
+    context->pool_users--;
+    ownSpinUnlock(&context->pool_lock);
+}
+
+own_arena ownGetScratchArena(void)
+{
+    vx_context context = ownGetContext();
+    if (!context)
+        return NULL;
+
+    if (t_arena && t_arena_context == context && t_arena_context_id == context->id)
+        return t_arena;
+
+    ownSpinLock(&context->arena_lock);
+    own_arena arena = context->arenas;
+    while (arena && arena->in_use)
+        arena = arena->next;
+    if (!arena)
+    {
+        arena = ownCreateArena(context->scratch_size);
+        if (arena)
+        {
+            arena->next = context->arenas;
+            context->arenas = arena;
+        }
+    }
+    if (arena)
+        arena->in_use = 1;
+    ownSpinUnlock(&context->arena_lock);
+
+    t_arena = arena;
+    t_arena_context = context;
+    t_arena_context_id = context->id;
+    if (arena)
+        ownWatchThreadExit(context);
+    return arena;
+}
+
+void ownReleaseScratchArena(vx_context context)
+{
+    // a stale context is only compared, never read
+    if (!t_arena || !context || t_arena_context != context || t_arena_context_id != context->id)
+        return;
+
+    ownSpinLock(&context->arena_lock);
+    t_arena->in_use = 0;
+    ownSpinUnlock(&context->arena_lock);
+
+    t_arena = NULL;
+    t_arena_context = NULL;
+}
+
+void ownWatchThreadExit(vx_context context)
+{
+    if (g_exit_key_ready)
+        ownSetTlsValue(g_exit_key, context);
+}
+
+VX_API_ENTRY vx_context VX_API_CALL vxCreateContext()
+{
+    ownSpinLock(&g_context_lock);
+    if (!g_context)
+        g_context = CreateContext();
+    if (g_context)
+        g_context->ref_count++;
+    vx_context context = g_context;
+    ownSpinUnlock(&g_context_lock);
+
+    return context;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseContext(vx_context *context)
+{
+    if (!context || !*context)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    vx_status status = VX_SUCCESS;
+
+    ownSpinLock(&g_context_lock);
+    if (*context != g_context || g_context->ref_count <= 0)
+    {
+        status = VX_ERROR_INVALID_REFERENCE;
+    }
+    else if (--g_context->ref_count == 0)
+    {
+        DestroyContext(g_context);
+        g_context = NULL;
+    }
+    ownSpinUnlock(&g_context_lock);
+
+    if (status == VX_SUCCESS)
+        *context = NULL;
+    return status;
+}
+
+VX_API_ENTRY vx_context VX_API_CALL vxGetContext(vx_reference reference)
+{
+    return reference ? ownGetContext() : NULL;
+}
+
+// Objects are not created in an error state: a failed creation returns NULL
+VX_API_ENTRY vx_status VX_API_CALL vxGetStatus(vx_reference reference)
+{
+    return reference ? VX_SUCCESS : VX_ERROR_NO_RESOURCES;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryContext(vx_context context, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!context || context != g_context)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_CONTEXT_ATTRIBUTE_VENDOR_ID:
+        if (size != sizeof(vx_uint16))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint16*)ptr = VX_ID_DEFAULT;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_VERSION:
+        if (size != sizeof(vx_uint16))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint16*)ptr = (vx_uint16)VX_VERSION;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_IMPLEMENTATION:
+        if (size < sizeof(IMPLEMENTATION_NAME))
+            return VX_ERROR_INVALID_PARAMETERS;
+        memcpy(ptr, IMPLEMENTATION_NAME, sizeof(IMPLEMENTATION_NAME));
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_NUM_THREADS_EXT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = context->num_threads;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_IMAGE_BORDER_EXT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = context->image_border;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_IMMEDIATE_BORDER_MODE:
+        if (size != sizeof(vx_border_mode_t))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_border_mode_t*)ptr = context->immediate_border;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_SCRATCH_SIZE_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = context->scratch_size;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_SCRATCH_HIGH_WATER_EXT:
+    {
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        vx_size high_water = 0;
+        ownSpinLock(&context->arena_lock);
+        for (own_arena arena = context->arenas; arena; arena = arena->next)
+        {
+            if (arena->high_water > high_water)
+                high_water = arena->high_water;
+        }
+        ownSpinUnlock(&context->arena_lock);
+
+        *(vx_size*)ptr = high_water;
+        return VX_SUCCESS;
+    }
+
+    case VX_CONTEXT_ATTRIBUTE_TARGET_EXT:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = context->target;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetContextAttribute(vx_context context, vx_enum attribute, const void *ptr, vx_size size)
+{
+    if (!context || context != g_context)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_CONTEXT_ATTRIBUTE_NUM_THREADS_EXT:
+    {
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        const vx_uint32 num_threads = *(const vx_uint32*)ptr;
+
+        // a running graph or parallel loop keeps its pool, so the size
+        // cannot change under it
+        ownSpinLock(&context->pool_lock);
+        if (context->pool_users != 0)
+        {
+            ownSpinUnlock(&context->pool_lock);
+            return VX_FAILURE;
+        }
+        own_thread_pool pool = context->pool;
+        context->pool = NULL;
+        context->num_threads = num_threads ? num_threads : ownGetNumCpus();
+        ownSpinUnlock(&context->pool_lock);
+
+        // the pool is recreated with the new size on the next parallel call;
+        // its workers are joined outside the spinlock
+        ownReleaseThreadPool(&pool);
+        return VX_SUCCESS;
+    }
+
+    case VX_CONTEXT_ATTRIBUTE_IMAGE_BORDER_EXT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        context->image_border = *(const vx_uint32*)ptr;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_IMMEDIATE_BORDER_MODE:
+    {
+        if (size != sizeof(vx_border_mode_t))
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        const vx_border_mode_t* border = (const vx_border_mode_t*)ptr;
+        if (border->mode != VX_BORDER_MODE_UNDEFINED && border->mode != VX_BORDER_MODE_CONSTANT &&
+            border->mode != VX_BORDER_MODE_REPLICATE)
+            return VX_ERROR_INVALID_VALUE;
+
+        context->immediate_border = *border;
+        return VX_SUCCESS;
+    }
+
+    case VX_CONTEXT_ATTRIBUTE_SCRATCH_SIZE_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        context->scratch_size = *(const vx_size*)ptr;
+        return VX_SUCCESS;
+
+    case VX_CONTEXT_ATTRIBUTE_TARGET_EXT:
+    {
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        const vx_enum target = *(const vx_enum*)ptr;
+        if (target != VX_TARGET_ANY_EXT && target != VX_TARGET_REF_EXT && target != VX_TARGET_SSE_EXT && target != VX_TARGET_AVX2_EXT)
+            return VX_ERROR_INVALID_VALUE;
+
+        // nodes keep the implementation they got until the graph is verified again
+        context->target = target;
+        return VX_SUCCESS;
+    }
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxHint(vx_reference reference, vx_enum hint)
+{
+    if (!reference)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    if ((vx_context)reference == g_context && hint == VX_HINT_SERIALIZE)
+    {
+        const vx_uint32 one = 1;
+        return vxSetContextAttribute(g_context, VX_CONTEXT_ATTRIBUTE_NUM_THREADS_EXT, &one, sizeof(one));
+    }
+
+    return VX_ERROR_NOT_SUPPORTED;
+}
@@ -0,0 +1,143 @@
+/*
+    File: context.h
+    Содержит внутреннее представление контекста OpenVX.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __CONTEXT_H__
+#define __CONTEXT_H__
+
+#include "types.h"
+#include "vx_ext.h"
+#include "platform.h"
+#include "parallel.h"
+#include "arena.h"
+#include "log.h"
+
+/*
+    Structure: _vx_context
+    Контекст библиотеки. Контекст единственный на процесс: <vxCreateContext>
+    возвращает существующий контекст, увеличивая счётчик ссылок.
+*/
+struct _vx_context
+{
+    //Variable: ref_count
+    //количество ссылок на контекст;
+    volatile int32_t ref_count;
+    //Variable: num_threads
+    //количество потоков для параллельного исполнения функций (включая вызывающий);
+    uint32_t num_threads;
+    //Variable: pool
+    //пул рабочих потоков, создаётся при первом параллельном вызове;
+    own_thread_pool pool;
+    //Variable: pool_lock
+    //блокировка создания и пересоздания пула;
+    volatile int32_t pool_lock;
+    //Variable: pool_users
+    //количество параллельных циклов и исполнений графов, использующих пул
+    //(см. <ownAcquireThreadPool>); изменяется под pool_lock;
+    int32_t pool_users;
+    //Variable: image_border
+    //ширина рамки изображений, создаваемых <vxCreateImage>;
+    uint32_t image_border;
+    //Variable: immediate_border
+    //режим границы функций ref_* (VX_CONTEXT_ATTRIBUTE_IMMEDIATE_BORDER_MODE);
+    vx_border_mode_t immediate_border;
+    //Variable: id
+    //номер контекста, уникальный в пределах процесса;
+    uint32_t id;
+    //Variable: arenas
+    //арены временной памяти потоков (см. <ownGetScratchArena>);
+    own_arena arenas;
+    //Variable: scratch_size
+    //начальный размер арены потока в байтах;
+    size_t scratch_size;
+    //Variable: arena_lock
+    //блокировка списка арен;
+    volatile int32_t arena_lock;
+    //Variable: log_callback
+    //обработчик журнала, см. <vxRegisterLogCallback>;
+    vx_log_callback_f log_callback;
+    //Variable: log_enabled
+    //1, если обработчик журнала зарегистрирован (без него записи не добавляются);
+    volatile int32_t log_enabled;
+    //Variable: log_rings
+    //кольцевые буферы журнала потоков (см. <own_log_ring>);
+    own_log_ring log_rings;
+    //Variable: log_lock
+    //блокировка списка буферов журнала;
+    volatile int32_t log_lock;
+    //Variable: log_draining
+    //блокировка выдачи журнала: записи выдаёт один поток за раз;
+    volatile int32_t log_draining;
+    //Variable: delays
+    //задержки контекста (по ним узлы находят объекты слотов, см. <ownFindDelaySlot>);
+    vx_delay delays;
+    //Variable: delay_lock
+    //блокировка списка задержек;
+    volatile int32_t delay_lock;
+    //Variable: target
+    //реализация ядер, которую выбирают узлы (VX_CONTEXT_ATTRIBUTE_TARGET_EXT);
+    vx_enum target;
+    //Variable: kernels
+    //ядра, добавленные <vxAddKernel>;
+    vx_kernel kernels;
+    //Variable: kernel_lock
+    //блокировка ядер контекста и реализаций ядер.
+    volatile int32_t kernel_lock;
+};
+
+/*
+    Function: ownGetContext
+    Возвращает контекст процесса. Если приложение не создало контекст,
+    создаётся контекст по умолчанию, чтобы функции ref_* можно было
+    вызывать без него.
+*/
+vx_context ownGetContext(void);
+
+/*
+    Function: ownAcquireThreadPool
+    Возвращает пул потоков контекста, создавая его при необходимости, и
+    отмечает, что пул используется: пока пул не отпущен <ownDropThreadPool>,
+    количество потоков контекста не меняется. Возвращает NULL, если функции
+    должны исполняться на вызывающем потоке.
+*/
+own_thread_pool ownAcquireThreadPool(vx_context context);
+
+/*
+    Function: ownDropThreadPool
+    Отпускает пул, полученный <ownAcquireThreadPool>. pool может быть NULL.
+*/
+void ownDropThreadPool(vx_context context, own_thread_pool pool);
+
+/*
+    Function: ownGetScratchArena
+    Возвращает арену временной памяти вызывающего потока. Функция берёт
+    отметку <ownArenaMark> в начале работы и откатывает арену к ней перед
+    возвратом, поэтому вложенные вызовы на одном потоке безопасны.
+
+    Return:
+        Арена или NULL, если её не удалось создать (<ownArenaAlloc> тогда
+        возвращает NULL).
+*/
+own_arena ownGetScratchArena(void);
+
+/*
+    Function: ownReleaseScratchArena
+    Открепляет арену от вызывающего потока, чтобы её мог взять другой поток,
+    если поток получил её от контекста context. Вызывается рабочими потоками
+    пула перед завершением, остальными потоками - при завершении (см.
+    <ownWatchThreadExit>).
+*/
+void ownReleaseScratchArena(vx_context context);
+
+/*
+    Function: ownWatchThreadExit
+    Запоминает, что вызывающий поток взял арену или кольцевой буфер журнала
+    контекста context: при завершении потока они вернутся контексту, и
+    короткоживущие потоки приложения не копят их до уничтожения контекста.
+    Рабочие потоки пула возвращают их сами и передают NULL.
+*/
+void ownWatchThreadExit(vx_context context);
+
+#endif // __CONTEXT_H__
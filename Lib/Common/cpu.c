@@ -0,0 +1,111 @@
+/*
+    File: cpu.c
+    Содержит определение возможностей процессора во время исполнения.
+
+    Date: 18 Октября 2026
+*/
+
+#include "cpu.h"
+#include "platform.h"
+
+#ifdef VX_ARCH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#define CPU_FEATURES_UNKNOWN 0x80000000u
+
+static volatile uint32_t g_cpu_features = CPU_FEATURES_UNKNOWN;
+
+// Instruction sets the current thread may use, see ownSetCpuFeatureMask
+static OWN_THREAD_LOCAL uint32_t t_feature_mask = ~0u;
+
+#ifdef VX_ARCH_X86
+
+static void CpuId(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    regs[0] = (uint32_t)info[0];
+    regs[1] = (uint32_t)info[1];
+    regs[2] = (uint32_t)info[2];
+    regs[3] = (uint32_t)info[3];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t XGetBv(uint32_t index)
+{
+#if defined(_MSC_VER)
+    return (uint64_t)_xgetbv(index);
+#else
+    uint32_t eax;
+    uint32_t edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+    return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+static uint32_t DetectCpuFeatures(void)
+{
+    uint32_t regs[4];
+    uint32_t features = 0;
+
+    CpuId(0, 0, regs);
+    const uint32_t max_leaf = regs[0];
+    if (max_leaf < 1)
+        return 0;
+
+    CpuId(1, 0, regs);
+    if (regs[3] & (1u << 26))
+        features |= VX_CPU_FEATURE_SSE2;
+    if (regs[2] & (1u << 9))
+        features |= VX_CPU_FEATURE_SSSE3;
+    if (regs[2] & (1u << 19))
+        features |= VX_CPU_FEATURE_SSE41;
+
+    // AVX registers must be enabled by the OS (OSXSAVE + XMM/YMM state in XCR0)
+    const int os_avx = (regs[2] & (1u << 27)) && (regs[2] & (1u << 28)) && ((XGetBv(0) & 0x6) == 0x6);
+
+    if (os_avx && max_leaf >= 7)
+    {
+        CpuId(7, 0, regs);
+        if (regs[1] & (1u << 5))
+            features |= VX_CPU_FEATURE_AVX2;
+    }
+
+    return features;
+}
+
+#else
+
+static uint32_t DetectCpuFeatures(void)
+{
+    return 0;
+}
+
+#endif
+
+uint32_t ownGetCpuFeatures(void)
+{
+    uint32_t features = g_cpu_features;
+    if (features == CPU_FEATURES_UNKNOWN)
+    {
+        // concurrent callers compute the same value, so the race is benign
+        features = DetectCpuFeatures();
+        g_cpu_features = features;
+    }
+    return features & t_feature_mask;
+}
+
+uint32_t ownSetCpuFeatureMask(uint32_t mask)
+{
+    const uint32_t previous = t_feature_mask;
+    t_feature_mask = mask;
+    return previous;
+}
@@ -0,0 +1,68 @@
+/*
+    File: cpu.h
+    Содержит определение возможностей процессора во время исполнения и макросы
+    для компиляции SIMD-версий функций.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __CPU_H__
+#define __CPU_H__
+
+#include <stdint.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define VX_ARCH_X86 1
+#endif
+
+#ifdef VX_ARCH_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+/*
+    Macros: VX_TARGET_AVX2, VX_TARGET_SSSE3
+    Помечают функцию, использующую соответствующий набор инструкций. MSVC
+    позволяет использовать интринсики без флагов компиляции, GCC и Clang
+    требуют явного атрибута.
+*/
+#if defined(__GNUC__) || defined(__clang__)
+#define VX_TARGET_AVX2  __attribute__((target("avx2")))
+#define VX_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#define VX_TARGET_AVX2
+#define VX_TARGET_SSSE3
+#endif
+
+/*
+    Enum: vx_cpu_feature_e
+    Наборы инструкций, проверяемые при выборе реализации функции.
+*/
+enum vx_cpu_feature_e
+{
+    VX_CPU_FEATURE_SSE2  = 0x1,
+    VX_CPU_FEATURE_SSSE3 = 0x2,
+    VX_CPU_FEATURE_SSE41 = 0x4,
+    VX_CPU_FEATURE_AVX2  = 0x8
+};
+
+/*
+    Function: ownGetCpuFeatures
+    Возвращает битовую маску <vx_cpu_feature_e> наборов инструкций, которые
+    поддерживаются процессором и операционной системой. Определение
+    выполняется один раз, затем возвращается сохранённое значение.
+*/
+uint32_t ownGetCpuFeatures(void);
+
+/*
+    Function: ownSetCpuFeatureMask
+    Ограничивает наборы инструкций, которые <ownGetCpuFeatures> сообщает
+    вызывающему потоку, маской mask. Так исполнение узла на выбранной
+    реализации ядра (см. <own_kernel_impl>) не использует более новые
+    наборы. Маска по умолчанию - все наборы.
+
+    Return:
+        Предыдущая маска потока, которую нужно восстановить.
+*/
+uint32_t ownSetCpuFeatureMask(uint32_t mask);
+
+#endif // __CPU_H__
@@ -0,0 +1,157 @@
+/*
+    File: delay.c
+    Содержит реализацию функций задержки OpenVX.
+
+    Date: 18 Октября 2026
+*/
+
+#include "delay.h"
+#include "context.h"
+
+#include <stdlib.h>
+
+vx_reference ownGetDelayReference(const vx_delay delay, int32_t index)
+{
+    return delay->objects[(delay->base + (uint32_t)-index) % delay->count];
+}
+
+bool ownFindDelaySlot(vx_context context, vx_reference ref, vx_delay* delay, int32_t* index)
+{
+    bool found = false;
+
+    ownSpinLock(&context->delay_lock);
+    for (vx_delay d = context->delays; d && !found; d = d->next)
+    {
+        for (uint32_t k = 0; k < d->count; k++)
+        {
+            if (d->objects[k] != ref)
+                continue;
+
+            *delay = d;
+            *index = -(int32_t)((k + d->count - d->base) % d->count);
+            found = true;
+            break;
+        }
+    }
+    ownSpinUnlock(&context->delay_lock);
+
+    return found;
+}
+
+static void ReleaseObjects(vx_delay delay)
+{
+    for (uint32_t k = 0; k < delay->count; k++)
+    {
+        vx_image image = (vx_image)delay->objects[k];
+        if (image)
+            vxReleaseImage(&image);
+    }
+    free(delay->objects);
+}
+
+VX_API_ENTRY vx_delay VX_API_CALL vxCreateDelay(vx_context context, vx_reference exemplar, vx_size slots)
+{
+    const vx_image image = (vx_image)exemplar;
+
+    // the slots copy the size and format of the exemplar, which a virtual
+    // image may not have yet
+    if (!context || !image || image->scope || slots == 0 || slots > INT32_MAX)
+        return NULL;
+
+    vx_delay delay = (vx_delay)calloc(1, sizeof(struct _vx_delay));
+    if (!delay)
+        return NULL;
+
+    delay->count = (uint32_t)slots;
+    delay->base = 0;
+    delay->objects = (vx_reference*)calloc(slots, sizeof(vx_reference));
+    bool created = delay->objects != NULL;
+    for (uint32_t k = 0; k < delay->count && created; k++)
+    {
+        delay->objects[k] = (vx_reference)vxCreateImage(context, image->width, image->height, image->image_type);
+        created = delay->objects[k] != NULL;
+    }
+
+    if (!created)
+    {
+        if (delay->objects)
+            ReleaseObjects(delay);
+        free(delay);
+        return NULL;
+    }
+
+    ownSpinLock(&context->delay_lock);
+    delay->next = context->delays;
+    context->delays = delay;
+    ownSpinUnlock(&context->delay_lock);
+
+    return delay;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseDelay(vx_delay *delay)
+{
+    if (!delay || !*delay)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    vx_delay d = *delay;
+    vx_context context = ownGetContext();
+
+    ownSpinLock(&context->delay_lock);
+    vx_delay* link = &context->delays;
+    while (*link && *link != d)
+        link = &(*link)->next;
+    if (*link)
+        *link = d->next;
+    ownSpinUnlock(&context->delay_lock);
+
+    ReleaseObjects(d);
+    free(d);
+
+    *delay = NULL;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryDelay(vx_delay delay, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!delay)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_DELAY_ATTRIBUTE_TYPE:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = VX_TYPE_IMAGE;
+        return VX_SUCCESS;
+
+    case VX_DELAY_ATTRIBUTE_SLOTS:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = delay->count;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_reference VX_API_CALL vxGetReferenceFromDelay(vx_delay delay, vx_int32 index)
+{
+    if (!delay || index > 0 || index <= -(vx_int32)delay->count)
+        return NULL;
+
+    return ownGetDelayReference(delay, index);
+}
+
+// Nodes bound to the slots pick up the new objects when their graph starts
+// (see the delay uses of the graph), so nothing is copied or rebound here
+VX_API_ENTRY vx_status VX_API_CALL vxAgeDelay(vx_delay delay)
+{
+    if (!delay)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    delay->base = (delay->base + delay->count - 1) % delay->count;
+    return VX_SUCCESS;
+}
@@ -0,0 +1,54 @@
+/*
+    File: delay.h
+    Содержит внутреннее представление задержки <vx_delay>.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __DELAY_H__
+#define __DELAY_H__
+
+#include "types.h"
+
+/*
+    Structure: _vx_delay
+    Задержка: кольцо из count заранее созданных объектов. Слот с номером
+    index (от -(count-1) до 0) хранит объект objects[(base - index) % count],
+    поэтому <vxAgeDelay> только сдвигает base, а данные не копируются.
+
+    Пока поддерживаются только задержки изображений: объекты библиотеки не
+    хранят свой тип, и задержка создаёт слоты по образцу-изображению.
+*/
+struct _vx_delay
+{
+    //Variable: objects
+    //объекты слотов в порядке создания;
+    vx_reference* objects;
+    //Variable: count
+    //количество слотов;
+    uint32_t count;
+    //Variable: base
+    //номер в objects объекта слота 0;
+    uint32_t base;
+    //Variable: next
+    //следующая задержка в списке задержек контекста.
+    struct _vx_delay* next;
+};
+
+/*
+    Function: ownGetDelayReference
+    Возвращает объект, который сейчас хранит слот index задержки.
+*/
+vx_reference ownGetDelayReference(const vx_delay delay, int32_t index);
+
+/*
+    Function: ownFindDelaySlot
+    Ищет задержку контекста, которой принадлежит объект ref, и слот, в
+    котором он сейчас находится.
+
+    Return:
+        true  - объект принадлежит задержке *delay и хранится в слоте *index;
+        false - объект не принадлежит задержкам.
+*/
+bool ownFindDelaySlot(vx_context context, vx_reference ref, vx_delay* delay, int32_t* index);
+
+#endif // __DELAY_H__
@@ -0,0 +1,650 @@
+/*
+    File: fusion.c
+    Содержит слияние цепочек поэлементных узлов графа в один проход по
+    пикселям.
+
+    Date: 18 Октября 2026
+*/
+
+#include "graph.h"
+#include "image.h"
+#include "arena.h"
+#include "context.h"
+#include "cpu.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Pixels a part of a row that runs through every operation before the next
+// part; the registers of a fused node stay in the first level cache
+#define CHUNK_PIXELS 1024
+
+#define NO_INDEX 0xFFFFFFFFu
+
+// Where the object of a parameter of the fused node comes from
+typedef struct
+{
+    uint32_t member;
+    uint32_t index;
+} FusedSource;
+
+/*
+    An operation of the program reads and writes registers, one register per
+    image of the chain. A register is a part of a row: of the image itself
+    for a parameter of the fused node, or a buffer of the thread for an image
+    only the chain uses. The tables are folded from the steps at every run,
+    as a threshold may change between runs.
+*/
+typedef struct
+{
+    uint32_t code;
+    uint32_t dst;
+    uint32_t src[2];
+    uint32_t first_step;
+    uint32_t num_steps;
+} FusedOp;
+
+typedef struct
+{
+    struct _vx_node node;
+    struct _vx_kernel kernel;
+    vx_node* members;
+    uint32_t num_members;
+    FusedSource sources[OWN_MAX_KERNEL_PARAMS];
+    FusedOp* ops;
+    uint32_t num_ops;
+    // members whose tables make the table of an operation, by operation
+    vx_node* steps;
+    // parameter of the fused node per register or NO_INDEX
+    uint32_t* registers;
+    uint32_t num_registers;
+} FusedNode;
+
+static bool IsWrittenBy(const vx_node node, vx_reference ref)
+{
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->kernel->directions[p] == VX_OUTPUT && node->params[p] == ref)
+            return true;
+    }
+    return false;
+}
+
+static bool UsesObject(const vx_node node, vx_reference ref)
+{
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->params[p] == ref)
+            return true;
+    }
+    return false;
+}
+
+static vx_image GetOutputImage(const vx_node node)
+{
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->kernel->directions[p] == VX_OUTPUT && node->kernel->types[p] == VX_TYPE_IMAGE)
+            return (vx_image)node->params[p];
+    }
+    return NULL;
+}
+
+static bool IsFusable(const vx_node node)
+{
+    // an implementation the application added runs as it is
+    if (node->impl.function)
+        return false;
+
+    own_pixel_op op;
+    return node->kernel->pixel && node->kernel->pixel(node, &op);
+}
+
+// An image the chain at positions [first, last] of the execution order
+// writes is needed outside it when it is not virtual or another node uses it
+static bool IsNeededOutside(const vx_graph graph, uint32_t first, uint32_t last, const vx_image image)
+{
+    if (!image->scope)
+        return true;
+
+    for (uint32_t n = 0; n < graph->num_order; n++)
+    {
+        if ((n < first || n > last) && UsesObject(graph->order[n], (vx_reference)image))
+            return true;
+    }
+    return false;
+}
+
+/*
+    The parameters of the fused node are the objects the chain reads from
+    outside, then the images needed outside the chain. Fills the node and
+    the kernel of fused when it is not NULL, as far as they fit. Returns the
+    number of parameters the chain needs.
+*/
+static uint32_t CollectParams(const vx_graph graph, uint32_t first, uint32_t last, FusedNode* fused)
+{
+    vx_reference refs[OWN_MAX_KERNEL_PARAMS];
+    uint32_t count = 0;
+
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        const vx_enum direction = pass == 0 ? VX_INPUT : VX_OUTPUT;
+        for (uint32_t k = first; k <= last; k++)
+        {
+            const vx_node member = graph->order[k];
+            for (uint32_t p = 0; p < member->kernel->num_params; p++)
+            {
+                const vx_reference ref = member->params[p];
+                if (member->kernel->directions[p] != direction || !ref)
+                    continue;
+
+                bool skip = false;
+                if (direction == VX_INPUT)
+                {
+                    for (uint32_t w = first; w < k && !skip; w++)
+                        skip = IsWrittenBy(graph->order[w], ref);
+                }
+                else
+                {
+                    skip = !IsNeededOutside(graph, first, last, (vx_image)ref);
+                }
+                for (uint32_t i = 0; i < count && i < OWN_MAX_KERNEL_PARAMS && !skip; i++)
+                    skip = refs[i] == ref;
+                if (skip)
+                    continue;
+
+                if (count < OWN_MAX_KERNEL_PARAMS)
+                {
+                    refs[count] = ref;
+                    if (fused)
+                    {
+                        fused->node.params[count] = ref;
+                        fused->kernel.directions[count] = direction;
+                        fused->kernel.types[count] = member->kernel->types[p];
+                        fused->sources[count].member = k - first;
+                        fused->sources[count].index = p;
+                    }
+                }
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static uint32_t FindParam(const FusedNode* fused, vx_reference ref)
+{
+    for (uint32_t p = 0; p < fused->kernel.num_params; p++)
+    {
+        if (fused->node.params[p] == ref)
+            return p;
+    }
+    return NO_INDEX;
+}
+
+// Returns the register of the image, adding it if the image has none yet
+static uint32_t GetRegister(vx_image* images, uint32_t* count, vx_image image)
+{
+    for (uint32_t r = 0; r < *count; r++)
+    {
+        if (images[r] == image)
+            return r;
+    }
+    images[*count] = image;
+    return (*count)++;
+}
+
+/*
+    Translates the members into operations. A table operation whose input
+    only it reads and only a table operation writes joins that operation:
+    the pixels go through one table instead of two. Registers no operation
+    uses after the joining are dropped.
+*/
+static vx_status CompileProgram(FusedNode* fused)
+{
+    const uint32_t num_members = fused->num_members;
+    const uint32_t max_registers = num_members * 3;
+
+    vx_image* images = (vx_image*)malloc(max_registers * sizeof(vx_image));
+    uint32_t* readers = (uint32_t*)calloc(max_registers, sizeof(uint32_t));
+    uint32_t* writers = (uint32_t*)malloc(max_registers * sizeof(uint32_t));
+    uint32_t* op_of = (uint32_t*)malloc(num_members * sizeof(uint32_t));
+    uint32_t* remap = (uint32_t*)malloc(max_registers * sizeof(uint32_t));
+    fused->ops = (FusedOp*)malloc(num_members * sizeof(FusedOp));
+    fused->steps = (vx_node*)malloc(num_members * sizeof(vx_node));
+    fused->registers = (uint32_t*)malloc(max_registers * sizeof(uint32_t));
+
+    vx_status status = VX_SUCCESS;
+    if (!images || !readers || !writers || !op_of || !remap || !fused->ops || !fused->steps || !fused->registers)
+        status = VX_ERROR_NO_MEMORY;
+
+    uint32_t num_images = 0;
+    for (uint32_t k = 0; k < num_members && status == VX_SUCCESS; k++)
+    {
+        const vx_node member = fused->members[k];
+        for (uint32_t p = 0; p < member->kernel->num_params; p++)
+        {
+            if (member->kernel->directions[p] == VX_INPUT && member->kernel->types[p] == VX_TYPE_IMAGE)
+                readers[GetRegister(images, &num_images, (vx_image)member->params[p])]++;
+        }
+    }
+
+    for (uint32_t r = 0; r < max_registers && status == VX_SUCCESS; r++)
+        writers[r] = NO_INDEX;
+
+    for (uint32_t k = 0; k < num_members && status == VX_SUCCESS; k++)
+    {
+        const vx_node member = fused->members[k];
+        own_pixel_op pixel;
+        if (!member->kernel->pixel(member, &pixel))
+        {
+            status = VX_ERROR_INVALID_NODE;
+            break;
+        }
+
+        FusedOp op;
+        uint32_t num_src = 0;
+        op.code = pixel.code;
+        op.src[0] = op.src[1] = 0;
+        for (uint32_t p = 0; p < member->kernel->num_params; p++)
+        {
+            if (member->kernel->directions[p] == VX_INPUT && member->kernel->types[p] == VX_TYPE_IMAGE && num_src < 2)
+                op.src[num_src++] = GetRegister(images, &num_images, (vx_image)member->params[p]);
+        }
+        op.dst = GetRegister(images, &num_images, GetOutputImage(member));
+
+        const uint32_t src = op.src[0];
+        const uint32_t writer = writers[src];
+        if (op.code == OWN_PIXEL_TABLE && writer != NO_INDEX && fused->ops[writer].code == OWN_PIXEL_TABLE &&
+            readers[src] == 1 && FindParam(fused, (vx_reference)images[src]) == NO_INDEX)
+        {
+            fused->ops[writer].dst = op.dst;
+            writers[op.dst] = writer;
+            op_of[k] = writer;
+            continue;
+        }
+
+        writers[op.dst] = fused->num_ops;
+        op_of[k] = fused->num_ops;
+        fused->ops[fused->num_ops++] = op;
+    }
+
+    if (status == VX_SUCCESS)
+    {
+        for (uint32_t r = 0; r < num_images; r++)
+            remap[r] = NO_INDEX;
+
+        uint32_t num_steps = 0;
+        for (uint32_t i = 0; i < fused->num_ops; i++)
+        {
+            FusedOp* op = &fused->ops[i];
+            const uint32_t num_src = op->code == OWN_PIXEL_TABLE ? 1 : 2;
+            for (uint32_t s = 0; s <= num_src; s++)
+            {
+                uint32_t* r = s < num_src ? &op->src[s] : &op->dst;
+                if (remap[*r] == NO_INDEX)
+                {
+                    remap[*r] = fused->num_registers;
+                    fused->registers[fused->num_registers++] = FindParam(fused, (vx_reference)images[*r]);
+                }
+                *r = remap[*r];
+            }
+            if (num_src == 1)
+                op->src[1] = op->src[0];
+
+            op->first_step = num_steps;
+            for (uint32_t k = 0; k < num_members; k++)
+            {
+                if (op_of[k] == i)
+                    fused->steps[num_steps++] = fused->members[k];
+            }
+            op->num_steps = num_steps - op->first_step;
+        }
+    }
+
+    free(images);
+    free(readers);
+    free(writers);
+    free(op_of);
+    free(remap);
+    return status;
+}
+
+static vx_status ProcessFused(vx_node node);
+
+static uint32_t HaloFused(vx_node node)
+{
+    (void)node;
+    return 0;
+}
+
+static void FreeFused(FusedNode* fused)
+{
+    for (uint32_t k = 0; k < fused->num_members; k++)
+        fused->members[k]->fused = NULL;
+    free(fused->node.successors);
+    free(fused->members);
+    free(fused->ops);
+    free(fused->steps);
+    free(fused->registers);
+    free(fused);
+}
+
+// Makes the nodes at positions [first, last] of the execution order one node
+static vx_status CreateFused(vx_graph graph, uint32_t first, uint32_t last, vx_node* node)
+{
+    const uint32_t count = last - first + 1;
+
+    FusedNode* fused = (FusedNode*)calloc(1, sizeof(FusedNode));
+    vx_node* all = (vx_node*)realloc(graph->fused, ((size_t)graph->num_fused + 1) * sizeof(vx_node));
+    if (all)
+        graph->fused = all;
+    if (fused)
+        fused->members = (vx_node*)malloc(count * sizeof(vx_node));
+    if (!fused || !all || !fused->members)
+    {
+        if (fused)
+            free(fused->members);
+        free(fused);
+        return VX_ERROR_NO_MEMORY;
+    }
+
+    fused->kernel.enumeration = VX_KERNEL_INVALID;
+    fused->kernel.name = "org.openvx_ext.fused";
+    fused->kernel.num_params = CollectParams(graph, first, last, fused);
+    // only the table lookups of the program have SIMD rows
+    static const own_kernel_impl impls[] =
+    {
+        { VX_TARGET_REF_EXT, 0, 0, ProcessFused, NULL },
+        { VX_TARGET_SSE_EXT, 1, VX_CPU_FEATURE_SSSE3, ProcessFused, NULL },
+        { VX_TARGET_AVX2_EXT, 2, VX_CPU_FEATURE_AVX2, ProcessFused, NULL },
+    };
+    memcpy(fused->kernel.impls, impls, sizeof(impls));
+    fused->kernel.num_impls = sizeof(impls) / sizeof(impls[0]);
+    fused->kernel.halo = HaloFused;
+
+    fused->node.graph = graph;
+    fused->node.kernel = &fused->kernel;
+    fused->node.status = ownSelectKernelImpl(&fused->node);
+    fused->node.fused = &fused->node;
+
+    for (uint32_t k = 0; k < count; k++)
+        fused->members[k] = graph->order[first + k];
+    fused->num_members = count;
+
+    const vx_status status = CompileProgram(fused);
+    if (status != VX_SUCCESS)
+    {
+        FreeFused(fused);
+        return status;
+    }
+
+    for (uint32_t k = 0; k < count; k++)
+        fused->members[k]->fused = &fused->node;
+    graph->fused[graph->num_fused++] = &fused->node;
+    *node = &fused->node;
+    return VX_SUCCESS;
+}
+
+void ownReleaseFusedNodes(vx_graph graph)
+{
+    for (uint32_t i = 0; i < graph->num_fused; i++)
+        FreeFused((FusedNode*)graph->fused[i]);
+    free(graph->fused);
+    graph->fused = NULL;
+    graph->num_fused = 0;
+}
+
+vx_status ownFuseNodes(vx_graph graph)
+{
+    ownReleaseFusedNodes(graph);
+
+    vx_node* order = (vx_node*)malloc(((size_t)graph->num_order + 1) * sizeof(vx_node));
+    if (!order)
+        return VX_ERROR_NO_MEMORY;
+
+    // chains are runs of the execution order, so no node outside a chain
+    // depends on one of its nodes and feeds another
+    vx_status status = VX_SUCCESS;
+    uint32_t count = 0;
+    uint32_t first = 0;
+    while (first < graph->num_order && status == VX_SUCCESS)
+    {
+        vx_node node = graph->order[first];
+        uint32_t end = first + 1;
+        if (IsFusable(node))
+        {
+            const vx_image output = GetOutputImage(node);
+            while (end < graph->num_order && IsFusable(graph->order[end]))
+            {
+                const vx_image next = GetOutputImage(graph->order[end]);
+                if (next->width != output->width || next->height != output->height ||
+                    CollectParams(graph, first, end, NULL) > OWN_MAX_KERNEL_PARAMS)
+                    break;
+                end++;
+            }
+        }
+
+        if (end - first > 1)
+            status = CreateFused(graph, first, end - 1, &node);
+        order[count++] = node;
+        first = end;
+    }
+
+    if (status != VX_SUCCESS)
+    {
+        free(order);
+        ownReleaseFusedNodes(graph);
+        return status;
+    }
+
+    free(graph->order);
+    graph->order = order;
+    graph->num_order = count;
+    return VX_SUCCESS;
+}
+
+void ownBindFusedParams(vx_graph graph)
+{
+    for (uint32_t i = 0; i < graph->num_fused; i++)
+    {
+        FusedNode* fused = (FusedNode*)graph->fused[i];
+        for (uint32_t p = 0; p < fused->kernel.num_params; p++)
+        {
+            const FusedSource* source = &fused->sources[p];
+            fused->node.params[p] = fused->members[source->member]->params[source->index];
+        }
+    }
+}
+
+const vx_node* ownGetFusedMembers(const vx_node node, uint32_t* count)
+{
+    const FusedNode* fused = (const FusedNode*)node->fused;
+    *count = fused->num_members;
+    return fused->members;
+}
+
+bool ownIsFusedInternal(const vx_graph graph, const vx_image image)
+{
+    for (uint32_t i = 0; i < graph->num_fused; i++)
+    {
+        const FusedNode* fused = (const FusedNode*)graph->fused[i];
+        for (uint32_t k = 0; k < fused->num_members; k++)
+        {
+            if (IsWrittenBy(fused->members[k], (vx_reference)image))
+                return FindParam(fused, (vx_reference)image) == NO_INDEX;
+        }
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    const FusedNode* fused;
+    // image per register, NULL for a register only the chain uses
+    const vx_image* images;
+    const uint8_t* tables;
+    uint32_t width;
+    // instruction sets of the node's target, see ownSetCpuFeatureMask
+    uint32_t features;
+    volatile int32_t out_of_memory;
+} FusedArgs;
+
+static void RunOp(const FusedOp* op, uint8_t* const* registers, uint32_t count, const uint8_t* table)
+{
+    const uint8_t* src1 = registers[op->src[0]];
+    const uint8_t* src2 = registers[op->src[1]];
+    uint8_t* dst = registers[op->dst];
+
+    switch (op->code)
+    {
+    case OWN_PIXEL_TABLE:
+        ownApplyLut8(src1, dst, count, table);
+        break;
+    case OWN_PIXEL_AND:
+        for (uint32_t i = 0; i < count; i++)
+            dst[i] = (uint8_t)(src1[i] & src2[i]);
+        break;
+    case OWN_PIXEL_OR:
+        for (uint32_t i = 0; i < count; i++)
+            dst[i] = (uint8_t)(src1[i] | src2[i]);
+        break;
+    default:
+        for (uint32_t i = 0; i < count; i++)
+            dst[i] = (uint8_t)(src1[i] ^ src2[i]);
+        break;
+    }
+}
+
+static void FusedRows(void* data, uint32_t y_begin, uint32_t y_end)
+{
+    FusedArgs* args = (FusedArgs*)data;
+    const FusedNode* fused = args->fused;
+    const uint32_t num_registers = fused->num_registers;
+    const uint32_t mask = ownSetCpuFeatureMask(args->features);
+
+    own_arena arena = ownGetScratchArena();
+    const size_t arena_mark = ownArenaMark(arena);
+    uint8_t** rows = (uint8_t**)ownArenaAlloc(arena, num_registers * sizeof(uint8_t*));
+    uint8_t** buffers = (uint8_t**)ownArenaAlloc(arena, num_registers * sizeof(uint8_t*));
+    uint8_t** registers = (uint8_t**)ownArenaAlloc(arena, num_registers * sizeof(uint8_t*));
+    bool failed = !rows || !buffers || !registers;
+
+    for (uint32_t r = 0; r < num_registers && !failed; r++)
+    {
+        const vx_image image = args->images[r];
+        buffers[r] = NULL;
+        if (!image)
+            buffers[r] = (uint8_t*)ownArenaAlloc(arena, CHUNK_PIXELS);
+        else if (!ownIsRowDense(image))
+            buffers[r] = (uint8_t*)ownArenaAlloc(arena, args->width);
+        failed = (!image || !ownIsRowDense(image)) && !buffers[r];
+    }
+
+    for (uint32_t y = y_begin; y < y_end && !failed; y++)
+    {
+        for (uint32_t r = 0; r < num_registers; r++)
+        {
+            const vx_image image = args->images[r];
+            if (!image)
+                rows[r] = NULL;
+            else if (fused->kernel.directions[fused->registers[r]] == VX_OUTPUT)
+                rows[r] = (uint8_t*)ownGetRowOutput(image, y, buffers[r]);
+            else
+                rows[r] = (uint8_t*)ownLoadRow(image, y, buffers[r]);
+        }
+
+        for (uint32_t x = 0; x < args->width; x += CHUNK_PIXELS)
+        {
+            const uint32_t count = args->width - x < CHUNK_PIXELS ? args->width - x : CHUNK_PIXELS;
+            for (uint32_t r = 0; r < num_registers; r++)
+                registers[r] = rows[r] ? rows[r] + x : buffers[r];
+            for (uint32_t i = 0; i < fused->num_ops; i++)
+                RunOp(&fused->ops[i], registers, count, args->tables + (size_t)i * OWN_LUT8_SIZE);
+        }
+
+        for (uint32_t r = 0; r < num_registers; r++)
+        {
+            if (rows[r] && fused->kernel.directions[fused->registers[r]] == VX_OUTPUT)
+                ownStoreRow(args->images[r], y, rows[r]);
+        }
+    }
+
+    if (failed)
+        args->out_of_memory = 1;
+
+    ownArenaReset(arena, arena_mark);
+    ownSetCpuFeatureMask(mask);
+}
+
+// The node may be a copy whose images are bands (see ownRunTileGroup), so
+// the images come from its parameters and the program from the fused node
+static vx_status ProcessFused(vx_node node)
+{
+    const FusedNode* fused = (const FusedNode*)node->fused;
+
+    own_arena arena = ownGetScratchArena();
+    const size_t arena_mark = ownArenaMark(arena);
+    vx_image* images = (vx_image*)ownArenaAlloc(arena, fused->num_registers * sizeof(vx_image));
+    uint8_t* tables = (uint8_t*)ownArenaAlloc(arena, (size_t)fused->num_ops * OWN_LUT8_SIZE);
+    if (!images || !tables)
+    {
+        ownArenaReset(arena, arena_mark);
+        return VX_ERROR_NO_MEMORY;
+    }
+
+    vx_image image = NULL;
+    size_t row_bytes = 0;
+    for (uint32_t r = 0; r < fused->num_registers; r++)
+    {
+        const uint32_t param = fused->registers[r];
+        images[r] = param == NO_INDEX ? NULL : (vx_image)node->params[param];
+        if (images[r])
+        {
+            image = images[r];
+            row_bytes += image->width;
+        }
+    }
+
+    vx_status status = VX_SUCCESS;
+    for (uint32_t i = 0; i < fused->num_ops && status == VX_SUCCESS; i++)
+    {
+        const FusedOp* op = &fused->ops[i];
+        uint8_t* table = tables + (size_t)i * OWN_LUT8_SIZE;
+        if (op->code != OWN_PIXEL_TABLE)
+            continue;
+
+        ownLutIdentity(table);
+        for (uint32_t s = 0; s < op->num_steps; s++)
+        {
+            const vx_node step = fused->steps[op->first_step + s];
+            own_pixel_op pixel;
+            if (!step->kernel->pixel(step, &pixel))
+            {
+                status = VX_ERROR_INVALID_NODE;
+                break;
+            }
+            ownLutAppend(table, pixel.table);
+        }
+    }
+
+    if (status == VX_SUCCESS && image)
+    {
+        FusedArgs args;
+        args.fused = fused;
+        args.images = images;
+        args.tables = tables;
+        args.width = image->width;
+        args.features = ownGetCpuFeatures();
+        args.out_of_memory = 0;
+
+        ownParallelFor(image->height, row_bytes, FusedRows, &args);
+        if (args.out_of_memory)
+            status = VX_ERROR_NO_MEMORY;
+    }
+
+    ownArenaReset(arena, arena_mark);
+    return status;
+}
@@ -0,0 +1,1726 @@
+/*
+    File: graph.c
+    Содержит реализацию графов и узлов OpenVX.
+
+    Date: 18 Октября 2026
+*/
+
+#include "graph.h"
+#include "context.h"
+#include "image.h"
+#include "delay.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_WRITER UINT32_MAX
+
+enum
+{
+    GRAPH_IDLE,
+    GRAPH_RUNNING,
+    GRAPH_COMPLETED
+};
+
+static bool IsObjectType(vx_enum type)
+{
+    return type != VX_TYPE_INT32 && type != VX_TYPE_UINT32 && type != VX_TYPE_ENUM;
+}
+
+static vx_status AppendPointer(void*** items, uint32_t count, void* item)
+{
+    void** grown = (void**)realloc(*items, ((size_t)count + 1) * sizeof(void*));
+    if (!grown)
+        return VX_ERROR_NO_MEMORY;
+
+    grown[count] = item;
+    *items = grown;
+    return VX_SUCCESS;
+}
+
+static vx_reference GetParameterValue(const vx_graph graph, uint32_t param)
+{
+    const struct _vx_parameter* parameter = &graph->params[param];
+    return parameter->node->params[parameter->index];
+}
+
+// Records the parameters of node that use the object of the graph parameter
+static vx_status AddParameterUses(vx_graph graph, uint32_t param, uint32_t node_index, const vx_node node)
+{
+    const vx_reference value = GetParameterValue(graph, param);
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->params[p] != value)
+            continue;
+
+        const uint32_t count = graph->num_param_uses;
+        own_parameter_use* grown = (own_parameter_use*)realloc(graph->param_uses, ((size_t)count + 1) * sizeof(own_parameter_use));
+        if (!grown)
+            return VX_ERROR_NO_MEMORY;
+
+        grown[count].param = param;
+        grown[count].node = node_index;
+        grown[count].index = p;
+        graph->param_uses = grown;
+        graph->num_param_uses++;
+    }
+    return VX_SUCCESS;
+}
+
+static bool IsParameterUse(const vx_graph graph, uint32_t node_index, uint32_t index)
+{
+    for (uint32_t i = 0; i < graph->num_param_uses; i++)
+    {
+        if (graph->param_uses[i].node == node_index && graph->param_uses[i].index == index)
+            return true;
+    }
+    return false;
+}
+
+// Substitutes the object of a graph parameter everywhere the graph uses it
+static void BindParameter(vx_graph graph, uint32_t param, vx_reference ref)
+{
+    for (uint32_t i = 0; i < graph->num_param_uses; i++)
+    {
+        const own_parameter_use* use = &graph->param_uses[i];
+        if (use->param == param)
+            graph->nodes[use->node]->params[use->index] = ref;
+    }
+    ownBindFusedParams(graph);
+}
+
+// Records the parameter of node if it holds the object of a delay slot
+static vx_status AddDelayUse(vx_graph graph, uint32_t node_index, const vx_node node, uint32_t index)
+{
+    vx_delay delay;
+    int32_t slot;
+    if (node->kernel->types[index] != VX_TYPE_IMAGE || !ownFindDelaySlot(graph->context, node->params[index], &delay, &slot))
+        return VX_SUCCESS;
+
+    const uint32_t count = graph->num_delay_uses;
+    own_delay_use* grown = (own_delay_use*)realloc(graph->delay_uses, ((size_t)count + 1) * sizeof(own_delay_use));
+    if (!grown)
+        return VX_ERROR_NO_MEMORY;
+
+    grown[count].delay = delay;
+    grown[count].slot = slot;
+    grown[count].node = node_index;
+    grown[count].index = index;
+    graph->delay_uses = grown;
+    graph->num_delay_uses++;
+    return VX_SUCCESS;
+}
+
+static vx_status AddDelayUses(vx_graph graph, uint32_t node_index, const vx_node node)
+{
+    vx_status status = VX_SUCCESS;
+    for (uint32_t p = 0; p < node->kernel->num_params && status == VX_SUCCESS; p++)
+        status = AddDelayUse(graph, node_index, node, p);
+    return status;
+}
+
+// Drops the use of the parameter among the first limit uses
+static void RemoveDelayUse(vx_graph graph, uint32_t node_index, uint32_t index, uint32_t limit)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < graph->num_delay_uses; i++)
+    {
+        if (i >= limit || graph->delay_uses[i].node != node_index || graph->delay_uses[i].index != index)
+            graph->delay_uses[count++] = graph->delay_uses[i];
+    }
+    graph->num_delay_uses = count;
+}
+
+// Points the parameters bound to delay slots at the objects the slots hold now
+static void BindDelays(vx_graph graph)
+{
+    if (graph->num_delay_uses == 0)
+        return;
+
+    for (uint32_t i = 0; i < graph->num_delay_uses; i++)
+    {
+        const own_delay_use* use = &graph->delay_uses[i];
+        graph->nodes[use->node]->params[use->index] = ownGetDelayReference(use->delay, use->slot);
+    }
+    ownBindFusedParams(graph);
+}
+
+static bool IsDelayUse(const vx_graph graph, const vx_node node, uint32_t index)
+{
+    for (uint32_t i = 0; i < graph->num_delay_uses; i++)
+    {
+        if (graph->nodes[graph->delay_uses[i].node] == node && graph->delay_uses[i].index == index)
+            return true;
+    }
+    return false;
+}
+
+/*
+    Checks an object that is about to replace the object of a graph parameter.
+    *same_layout is false when an image differs in size or format, so the
+    graph has to be verified again.
+*/
+static vx_status CheckParameterValue(const vx_graph graph, uint32_t param, vx_reference ref, bool* same_layout)
+{
+    const struct _vx_parameter* parameter = &graph->params[param];
+
+    *same_layout = true;
+    if (!ref)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    if (parameter->node->kernel->types[parameter->index] == VX_TYPE_IMAGE)
+    {
+        const vx_image image = (vx_image)ref;
+        const vx_image current = (vx_image)GetParameterValue(graph, param);
+        if (image->scope)
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        *same_layout = image->width == current->width && image->height == current->height &&
+            image->image_type == current->image_type;
+    }
+
+    // an object the graph already uses elsewhere would merge two data paths
+    for (uint32_t n = 0; n < graph->num_nodes; n++)
+    {
+        const vx_node node = graph->nodes[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (node->params[p] == ref && !IsParameterUse(graph, n, p))
+                return VX_ERROR_INVALID_PARAMETERS;
+        }
+    }
+    return VX_SUCCESS;
+}
+
+vx_node ownCreateNode(vx_graph graph, vx_kernel kernel, const vx_reference* refs, const vx_int32* values)
+{
+    if (!graph || !kernel)
+        return NULL;
+
+    for (uint32_t p = 0; p < kernel->num_params && refs; p++)
+    {
+        if (!IsObjectType(kernel->types[p]))
+            continue;
+
+        if (!refs[p])
+            return NULL;
+
+        // a virtual image can only connect nodes of the graph that created it
+        if (kernel->types[p] == VX_TYPE_IMAGE && ((vx_image)refs[p])->scope && ((vx_image)refs[p])->scope != graph)
+            return NULL;
+    }
+
+    vx_node node = (vx_node)calloc(1, sizeof(struct _vx_node));
+    if (!node)
+        return NULL;
+
+    node->graph = graph;
+    node->kernel = kernel;
+    node->impl.target = VX_TARGET_ANY_EXT;
+    for (uint32_t p = 0; p < kernel->num_params; p++)
+    {
+        if (IsObjectType(kernel->types[p]))
+            node->params[p] = refs ? refs[p] : NULL;
+        else
+            node->values[p] = values[p];
+    }
+    node->status = VX_SUCCESS;
+    node->origin = node;
+
+    // the new node follows the graph parameters and delay slots whose objects it uses
+    const uint32_t num_param_uses = graph->num_param_uses;
+    const uint32_t num_delay_uses = graph->num_delay_uses;
+    vx_status status = VX_SUCCESS;
+    for (uint32_t i = 0; i < graph->num_params && status == VX_SUCCESS; i++)
+        status = AddParameterUses(graph, i, graph->num_nodes, node);
+    if (status == VX_SUCCESS)
+        status = AddDelayUses(graph, graph->num_nodes, node);
+    if (status == VX_SUCCESS)
+        status = AppendPointer((void***)&graph->nodes, graph->num_nodes, node);
+
+    if (status != VX_SUCCESS)
+    {
+        graph->num_param_uses = num_param_uses;
+        graph->num_delay_uses = num_delay_uses;
+        free(node);
+        return NULL;
+    }
+    graph->num_nodes++;
+    graph->verified = 0;
+    return node;
+}
+
+vx_status ownAddVirtualImage(vx_graph graph, vx_image image)
+{
+    const vx_status status = AppendPointer((void***)&graph->virtuals, graph->num_virtuals, image);
+    if (status == VX_SUCCESS)
+    {
+        image->scope = graph;
+        graph->num_virtuals++;
+        graph->verified = 0;
+    }
+    return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Returns the index of the node that writes the object or NO_WRITER
+static uint32_t FindWriter(const vx_graph graph, vx_reference ref)
+{
+    for (uint32_t n = 0; n < graph->num_nodes; n++)
+    {
+        const vx_node node = graph->nodes[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (node->kernel->directions[p] == VX_OUTPUT && node->params[p] == ref)
+                return n;
+        }
+    }
+    return NO_WRITER;
+}
+
+static bool IsWrittenBy(const vx_node writer, vx_reference ref)
+{
+    for (uint32_t p = 0; p < writer->kernel->num_params; p++)
+    {
+        if (writer->kernel->directions[p] == VX_OUTPUT && writer->params[p] == ref)
+            return true;
+    }
+    return false;
+}
+
+// Counts the inputs of node that another node writes; an input written by
+// the node itself is a cycle
+static vx_status CountDependencies(const vx_graph graph, const vx_node node, uint32_t* count)
+{
+    *count = 0;
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->kernel->directions[p] != VX_INPUT || !node->params[p])
+            continue;
+
+        const uint32_t writer = FindWriter(graph, node->params[p]);
+        if (writer == NO_WRITER)
+            continue;
+        if (graph->nodes[writer] == node)
+            return VX_ERROR_INVALID_GRAPH;
+        (*count)++;
+    }
+    return VX_SUCCESS;
+}
+
+static vx_status CheckSingleWriter(const vx_graph graph)
+{
+    for (uint32_t n = 0; n < graph->num_nodes; n++)
+    {
+        const vx_node node = graph->nodes[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (node->kernel->directions[p] == VX_OUTPUT && FindWriter(graph, node->params[p]) != n)
+                return VX_ERROR_MULTIPLE_WRITERS;
+        }
+    }
+    return VX_SUCCESS;
+}
+
+/*
+    Kahn's algorithm: a node is ready once every node writing its inputs is
+    placed. Ready nodes are taken in the order they were added, so graphs
+    without dependencies run in the order they were built.
+*/
+static vx_status SortNodes(vx_graph graph)
+{
+    const uint32_t num_nodes = graph->num_nodes;
+    vx_status status = CheckSingleWriter(graph);
+    if (status != VX_SUCCESS)
+        return status;
+
+    uint32_t* pending = (uint32_t*)malloc(((size_t)num_nodes + 1) * sizeof(uint32_t));
+    vx_node* order = (vx_node*)malloc(((size_t)num_nodes + 1) * sizeof(vx_node));
+    if (!pending || !order)
+    {
+        free(pending);
+        free(order);
+        return VX_ERROR_NO_MEMORY;
+    }
+
+    for (uint32_t n = 0; n < num_nodes && status == VX_SUCCESS; n++)
+        status = CountDependencies(graph, graph->nodes[n], &pending[n]);
+
+    uint32_t placed = 0;
+    for (uint32_t n = 0; n < num_nodes && status == VX_SUCCESS; n++)
+    {
+        if (pending[n] == 0)
+            order[placed++] = graph->nodes[n];
+    }
+
+    // placing a node releases the inputs of its readers
+    for (uint32_t next = 0; next < placed; next++)
+    {
+        const vx_node writer = order[next];
+        for (uint32_t n = 0; n < num_nodes; n++)
+        {
+            const vx_node reader = graph->nodes[n];
+            if (pending[n] == 0)
+                continue;
+
+            for (uint32_t p = 0; p < reader->kernel->num_params; p++)
+            {
+                if (reader->kernel->directions[p] == VX_INPUT && reader->params[p] && IsWrittenBy(writer, reader->params[p]))
+                    pending[n]--;
+            }
+            if (pending[n] == 0)
+                order[placed++] = reader;
+        }
+    }
+
+    free(pending);
+
+    if (status == VX_SUCCESS && placed != num_nodes)
+        status = VX_ERROR_INVALID_GRAPH;
+
+    if (status != VX_SUCCESS)
+    {
+        free(order);
+        return status;
+    }
+
+    free(graph->order);
+    graph->order = order;
+    graph->num_order = num_nodes;
+    return VX_SUCCESS;
+}
+
+// Every virtual image a node reads has to be written by another node,
+// otherwise the reader would see undefined pixels
+static vx_status CheckVirtualInputs(const vx_graph graph)
+{
+    for (uint32_t n = 0; n < graph->num_nodes; n++)
+    {
+        const vx_node node = graph->nodes[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (node->kernel->directions[p] != VX_INPUT || node->kernel->types[p] != VX_TYPE_IMAGE)
+                continue;
+
+            if (((vx_image)node->params[p])->scope && FindWriter(graph, node->params[p]) == NO_WRITER)
+                return VX_ERROR_INVALID_GRAPH;
+        }
+    }
+    return VX_SUCCESS;
+}
+
+typedef struct
+{
+    vx_image image;
+    size_t size;
+    size_t offset;
+    uint32_t first;
+    uint32_t last;
+} VirtualBuffer;
+
+// Positions are indices in the execution order; a buffer is live from its
+// writer to its last reader, both inclusive
+static void GetLifetime(const vx_graph graph, vx_reference ref, uint32_t* first, uint32_t* last)
+{
+    *first = NO_WRITER;
+    *last = 0;
+    for (uint32_t n = 0; n < graph->num_order; n++)
+    {
+        const vx_node node = graph->order[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (node->params[p] != ref)
+                continue;
+            if (node->kernel->directions[p] == VX_OUTPUT)
+                *first = n;
+            *last = n;
+        }
+    }
+
+    // a group runs its nodes band after band, so an image it uses is live
+    // while any band of the group may run
+    if (*first != NO_WRITER && graph->order[*first]->group)
+        *first = graph->order[*first]->group->first;
+    if (*first != NO_WRITER && graph->order[*last]->group)
+        *last = graph->order[*last]->group->last;
+}
+
+static bool Overlaps(const VirtualBuffer* a, const VirtualBuffer* b)
+{
+    return a->first <= b->last && b->first <= a->last;
+}
+
+/*
+    Buffers whose lifetimes do not overlap may share memory, as registers do
+    in register allocation. Buffers are placed largest first, each at the
+    lowest offset that does not collide with an already placed buffer live
+    at the same time; the block is as large as the highest end.
+*/
+static size_t PlaceBuffers(VirtualBuffer* buffers, uint32_t count)
+{
+    // insertion sort by size, largest first
+    for (uint32_t i = 1; i < count; i++)
+    {
+        const VirtualBuffer buffer = buffers[i];
+        uint32_t j = i;
+        for (; j > 0 && buffers[j - 1].size < buffer.size; j--)
+            buffers[j] = buffers[j - 1];
+        buffers[j] = buffer;
+    }
+
+    size_t total = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        size_t offset = 0;
+        bool moved = true;
+        while (moved)
+        {
+            // move past every colliding buffer until none is left
+            moved = false;
+            for (uint32_t j = 0; j < i; j++)
+            {
+                if (Overlaps(&buffers[i], &buffers[j]) &&
+                    offset < buffers[j].offset + buffers[j].size && buffers[j].offset < offset + buffers[i].size)
+                {
+                    offset = buffers[j].offset + buffers[j].size;
+                    moved = true;
+                }
+            }
+        }
+
+        buffers[i].offset = offset;
+        if (offset + buffers[i].size > total)
+            total = offset + buffers[i].size;
+    }
+    return total;
+}
+
+// Fills buffers (num_virtuals entries) with the placed virtual images;
+// arrays and pyramids have no virtual form and are not planned
+static vx_status AllocateVirtuals(vx_graph graph, VirtualBuffer* buffers, uint32_t* num_buffers)
+{
+    const uint32_t border = graph->context->image_border;
+
+    ownAlignedFree(graph->memory);
+    graph->memory = NULL;
+    graph->memory_size = 0;
+    graph->memory_saved = 0;
+
+    uint32_t count = 0;
+    size_t separate = 0;
+    vx_status status = VX_SUCCESS;
+    for (uint32_t i = 0; i < graph->num_virtuals && status == VX_SUCCESS; i++)
+    {
+        vx_image image = graph->virtuals[i];
+        VirtualBuffer* buffer = &buffers[count];
+
+        // images inside a group only exist as bands, images inside a fused
+        // node only as parts of rows
+        if (ownIsTileInternal(graph, image) || ownIsFusedInternal(graph, image))
+        {
+            separate += ownGetImageAllocSize(image, border);
+            continue;
+        }
+
+        // images no node writes are not used (see CheckVirtualInputs)
+        GetLifetime(graph, (vx_reference)image, &buffer->first, &buffer->last);
+        if (buffer->first == NO_WRITER)
+            continue;
+
+        buffer->image = image;
+        buffer->size = ownGetImageAllocSize(image, border);
+        if (image->width == 0 || image->height == 0)
+            status = VX_ERROR_INVALID_DIMENSION;
+        else if (buffer->size == 0)
+            status = VX_ERROR_INVALID_FORMAT;
+
+        separate += buffer->size;
+        count++;
+    }
+
+    if (status == VX_SUCCESS && count > 0)
+    {
+        graph->memory_size = PlaceBuffers(buffers, count);
+        graph->memory = ownAlignedAlloc(graph->memory_size, OWN_IMAGE_ALIGNMENT);
+        if (!graph->memory)
+            status = VX_ERROR_NO_MEMORY;
+    }
+    graph->memory_saved = separate - graph->memory_size;
+
+    if (status == VX_SUCCESS && count > 0)
+    {
+        // the block is cleared once; later the border and padding of a buffer
+        // may hold data of another buffer sharing its memory, their content is
+        // undefined anyway
+        memset(graph->memory, 0, graph->memory_size);
+        for (uint32_t i = 0; i < count; i++)
+            ownBindImage(buffers[i].image, (uint8_t*)graph->memory + buffers[i].offset, border);
+    }
+
+    *num_buffers = count;
+    return status;
+}
+
+// A group runs as its first node; edges to and from its other nodes are
+// edges of the first node
+static uint32_t GetUnit(const vx_graph graph, uint32_t position)
+{
+    const vx_node node = graph->order[position];
+    return node->group ? node->group->first : position;
+}
+
+static bool IsUnit(const vx_node node)
+{
+    return !node->group || node->group->members[0] == node;
+}
+
+static void AddEdge(const vx_graph graph, uint8_t* edges, uint32_t from, uint32_t to)
+{
+    from = GetUnit(graph, from);
+    to = GetUnit(graph, to);
+    if (from != to)
+        edges[(size_t)from * graph->num_order + to] = 1;
+}
+
+static bool UsesObject(const vx_node node, vx_reference ref)
+{
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->params[p] == ref)
+            return true;
+    }
+    return false;
+}
+
+/*
+    Nodes run as soon as the nodes they depend on finish, so independent
+    nodes run in parallel. A node depends on the writers of its inputs and,
+    when its output shares memory with an earlier virtual image, on every
+    node using that image: otherwise it could overwrite the pixels before
+    they are read.
+*/
+static vx_status BuildEdges(vx_graph graph, const VirtualBuffer* buffers, uint32_t num_buffers)
+{
+    const uint32_t num_nodes = graph->num_order;
+
+    uint8_t* edges = (uint8_t*)calloc((size_t)num_nodes * num_nodes + 1, 1);
+    if (!edges)
+        return VX_ERROR_NO_MEMORY;
+
+    for (uint32_t r = 0; r < num_nodes; r++)
+    {
+        const vx_node reader = graph->order[r];
+        for (uint32_t p = 0; p < reader->kernel->num_params; p++)
+        {
+            if (reader->kernel->directions[p] != VX_INPUT || !reader->params[p])
+                continue;
+
+            for (uint32_t w = 0; w < r; w++)
+            {
+                if (IsWrittenBy(graph->order[w], reader->params[p]))
+                    AddEdge(graph, edges, w, r);
+            }
+        }
+    }
+
+    for (uint32_t a = 0; a < num_buffers; a++)
+    {
+        for (uint32_t b = 0; b < num_buffers; b++)
+        {
+            const bool shared = buffers[a].offset < buffers[b].offset + buffers[b].size &&
+                buffers[b].offset < buffers[a].offset + buffers[a].size;
+            if (!shared || buffers[a].last >= buffers[b].first)
+                continue;
+
+            for (uint32_t n = buffers[a].first; n <= buffers[a].last; n++)
+            {
+                if (UsesObject(graph->order[n], (vx_reference)buffers[a].image))
+                    AddEdge(graph, edges, n, buffers[b].first);
+            }
+        }
+    }
+
+    vx_status status = VX_SUCCESS;
+    graph->num_units = 0;
+    for (uint32_t from = 0; from < num_nodes; from++)
+    {
+        vx_node node = graph->order[from];
+        free(node->successors);
+        node->successors = NULL;
+        node->num_successors = 0;
+        node->num_predecessors = 0;
+        graph->num_units += IsUnit(node);
+
+        uint32_t count = 0;
+        for (uint32_t to = 0; to < num_nodes; to++)
+            count += edges[(size_t)from * num_nodes + to];
+        for (uint32_t to = 0; to < num_nodes; to++)
+            node->num_predecessors += edges[(size_t)to * num_nodes + from];
+
+        if (count == 0)
+            continue;
+
+        node->successors = (vx_node*)malloc(count * sizeof(vx_node));
+        if (!node->successors)
+        {
+            status = VX_ERROR_NO_MEMORY;
+            continue;
+        }
+        for (uint32_t to = 0; to < num_nodes; to++)
+        {
+            if (edges[(size_t)from * num_nodes + to])
+                node->successors[node->num_successors++] = graph->order[to];
+        }
+    }
+
+    free(edges);
+    return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static vx_status VerifyGraph(vx_graph graph);
+
+// Frames in flight share every object the graph does not replicate, so each
+// object a node writes has to be a virtual image or come with the frame
+static vx_status CheckStreamOutputs(const vx_graph graph)
+{
+    for (uint32_t n = 0; n < graph->num_nodes; n++)
+    {
+        const vx_node node = graph->nodes[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (node->kernel->directions[p] != VX_OUTPUT || !IsObjectType(node->kernel->types[p]))
+                continue;
+
+            const bool is_virtual = node->kernel->types[p] == VX_TYPE_IMAGE && ((vx_image)node->params[p])->scope;
+            if (!is_virtual && !IsParameterUse(graph, n, p))
+                return VX_ERROR_INVALID_GRAPH;
+        }
+    }
+    return VX_SUCCESS;
+}
+
+// Maps a virtual image of graph to its copy in replica; other objects are shared
+static vx_reference MapReference(const vx_graph graph, const vx_graph replica, vx_reference ref)
+{
+    for (uint32_t i = 0; i < graph->num_virtuals; i++)
+    {
+        if ((vx_reference)graph->virtuals[i] == ref)
+            return (vx_reference)replica->virtuals[i];
+    }
+    return ref;
+}
+
+static uint32_t FindNode(const vx_graph graph, const vx_node node)
+{
+    uint32_t n = 0;
+    while (n < graph->num_nodes && graph->nodes[n] != node)
+        n++;
+    return n;
+}
+
+/*
+    Copies the verified graph for one more frame in flight: the copy has its
+    own virtual images, with the sizes and formats the validators inferred,
+    and its own memory for them. The nodes are added in the same order, so
+    the parameter uses apply to the copy unchanged; the delay slots are
+    bound before the copy is made, so its nodes find the same slots.
+*/
+static vx_status CloneGraph(const vx_graph graph, vx_graph* replica)
+{
+    vx_graph copy = vxCreateGraph(graph->context);
+    if (!copy)
+        return VX_ERROR_NO_MEMORY;
+    copy->tile_size = graph->tile_size;
+    copy->origin = graph;
+
+    vx_status status = VX_SUCCESS;
+    for (uint32_t i = 0; i < graph->num_virtuals && status == VX_SUCCESS; i++)
+    {
+        vx_image image = (vx_image)malloc(sizeof(struct _vx_image));
+        if (!image)
+        {
+            status = VX_ERROR_NO_MEMORY;
+            break;
+        }
+
+        *image = *graph->virtuals[i];
+        image->data = NULL;
+        status = ownAddVirtualImage(copy, image);
+        if (status != VX_SUCCESS)
+            free(image);
+    }
+
+    for (uint32_t n = 0; n < graph->num_nodes && status == VX_SUCCESS; n++)
+    {
+        const vx_node node = graph->nodes[n];
+        vx_reference refs[OWN_MAX_KERNEL_PARAMS];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+            refs[p] = MapReference(graph, copy, node->params[p]);
+
+        vx_node copy_node = ownCreateNode(copy, node->kernel, refs, node->values);
+        if (copy_node)
+            copy_node->origin = node;
+        else
+            status = VX_ERROR_NO_MEMORY;
+    }
+
+    if (status == VX_SUCCESS)
+    {
+        copy->params = (struct _vx_parameter*)malloc(((size_t)graph->num_params + 1) * sizeof(struct _vx_parameter));
+        copy->param_uses = (own_parameter_use*)malloc(((size_t)graph->num_param_uses + 1) * sizeof(own_parameter_use));
+        if (!copy->params || !copy->param_uses)
+            status = VX_ERROR_NO_MEMORY;
+    }
+    if (status == VX_SUCCESS)
+    {
+        for (uint32_t i = 0; i < graph->num_params; i++)
+        {
+            copy->params[i].node = copy->nodes[FindNode(graph, graph->params[i].node)];
+            copy->params[i].index = graph->params[i].index;
+        }
+        copy->num_params = graph->num_params;
+        memcpy(copy->param_uses, graph->param_uses, graph->num_param_uses * sizeof(own_parameter_use));
+        copy->num_param_uses = graph->num_param_uses;
+
+        status = VerifyGraph(copy);
+    }
+
+    if (status != VX_SUCCESS)
+    {
+        vxReleaseGraph(&copy);
+        return status;
+    }
+
+    *replica = copy;
+    return VX_SUCCESS;
+}
+
+static void ReleaseReplicas(vx_graph graph)
+{
+    for (uint32_t i = 0; i < graph->num_replicas; i++)
+        vxReleaseGraph(&graph->replicas[i]);
+    free(graph->replicas);
+    free(graph->frame_refs);
+    graph->replicas = NULL;
+    graph->num_replicas = 0;
+    graph->frame_refs = NULL;
+    graph->frame_head = 0;
+}
+
+// Creates the copies of the graph for the frames in flight after the first
+static vx_status PrepareFrames(vx_graph graph)
+{
+    const uint32_t depth = graph->pipeline_depth;
+
+    ReleaseReplicas(graph);
+
+    vx_status status = depth > 1 ? CheckStreamOutputs(graph) : VX_SUCCESS;
+    if (status != VX_SUCCESS)
+        return status;
+
+    graph->frame_refs = (vx_reference*)calloc((size_t)depth * graph->num_params + 1, sizeof(vx_reference));
+    graph->replicas = (vx_graph*)calloc(depth, sizeof(vx_graph));
+    if (!graph->frame_refs || !graph->replicas)
+        status = VX_ERROR_NO_MEMORY;
+
+    for (uint32_t i = 0; i + 1 < depth && status == VX_SUCCESS; i++)
+    {
+        status = CloneGraph(graph, &graph->replicas[i]);
+        if (status == VX_SUCCESS)
+            graph->num_replicas++;
+    }
+
+    if (status != VX_SUCCESS)
+        ReleaseReplicas(graph);
+    return status;
+}
+
+// The objects of a generic node are set one by one; the order and memory of
+// the graph are planned with every object in place
+static vx_status CheckParametersSet(const vx_graph graph)
+{
+    for (uint32_t n = 0; n < graph->num_nodes; n++)
+    {
+        const vx_node node = graph->nodes[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (IsObjectType(node->kernel->types[p]) && !node->params[p])
+                return VX_ERROR_NOT_SUFFICIENT;
+        }
+    }
+    return VX_SUCCESS;
+}
+
+// Frees what the kernel gave the node at the previous verification
+static void DeinitializeNode(vx_node node)
+{
+    if (node->initialized && node->kernel->deinitialize)
+        node->kernel->deinitialize(node);
+    node->initialized = 0;
+}
+
+static vx_status VerifyGraph(vx_graph graph)
+{
+    graph->verified = 0;
+
+    for (uint32_t n = 0; n < graph->num_nodes; n++)
+        DeinitializeNode(graph->nodes[n]);
+
+    // the groups and fused nodes of the previous verification are in the old order
+    ownReleaseTileGroups(graph);
+    ownReleaseFusedNodes(graph);
+
+    // the validators and the copies of the graph see the objects the delay slots hold now
+    BindDelays(graph);
+
+    vx_status status = CheckParametersSet(graph);
+    if (status == VX_SUCCESS)
+        status = SortNodes(graph);
+    if (status == VX_SUCCESS)
+        status = CheckVirtualInputs(graph);
+
+    // readers are validated after their writers, which set the format and
+    // size of virtual images
+    for (uint32_t n = 0; n < graph->num_nodes && status == VX_SUCCESS; n++)
+    {
+        vx_node node = graph->order[n];
+        node->status = node->kernel->validate(node);
+        if (node->status == VX_SUCCESS)
+            node->status = ownSelectKernelImpl(node);
+        status = node->status;
+        if (status != VX_SUCCESS)
+            vxAddLogEntry((vx_reference)node, status, "%s: parameters failed validation", node->kernel->name);
+    }
+
+    if (status == VX_SUCCESS)
+        status = ownFuseNodes(graph);
+    if (status == VX_SUCCESS)
+        status = ownFormTileGroups(graph);
+
+    VirtualBuffer* buffers = NULL;
+    uint32_t num_buffers = 0;
+    if (status == VX_SUCCESS)
+    {
+        buffers = (VirtualBuffer*)malloc(((size_t)graph->num_virtuals + 1) * sizeof(VirtualBuffer));
+        status = buffers ? AllocateVirtuals(graph, buffers, &num_buffers) : VX_ERROR_NO_MEMORY;
+    }
+    if (status == VX_SUCCESS)
+        status = BuildEdges(graph, buffers, num_buffers);
+    free(buffers);
+
+    if (status == VX_SUCCESS)
+        status = PrepareFrames(graph);
+
+    graph->status = status;
+    graph->verified = status == VX_SUCCESS;
+    return status;
+}
+
+static void SubmitNode(vx_node node);
+
+// Adds a run from beg to end to the measurements, as vx_perf_t describes
+static void AddMeasurement(vx_perf_t* perf, uint64_t beg, uint64_t end)
+{
+    perf->beg = beg;
+    perf->end = end;
+    perf->tmp = end - beg;
+    perf->sum += perf->tmp;
+    perf->num++;
+    perf->avg = perf->sum / perf->num;
+    if (perf->num == 1 || perf->tmp < perf->min)
+        perf->min = perf->tmp;
+    if (perf->tmp > perf->max)
+        perf->max = perf->tmp;
+}
+
+static void RecordNode(const vx_node node, uint64_t beg, uint64_t end)
+{
+    if (node->fused != node)
+    {
+        AddMeasurement(&node->origin->perf, beg, end);
+        return;
+    }
+
+    uint32_t count;
+    const vx_node* members = ownGetFusedMembers(node, &count);
+    for (uint32_t k = 0; k < count; k++)
+        AddMeasurement(&members[k]->origin->perf, beg, end);
+}
+
+// Every node a unit runs is given the time of the whole unit; the nodes of
+// the copies of a graph count for the nodes of the graph
+static void RecordUnit(const vx_node node, uint64_t beg, uint64_t end)
+{
+    vx_graph origin = node->graph->origin;
+    ownLockMutex(&origin->lock);
+    if (!node->group)
+    {
+        RecordNode(node, beg, end);
+    }
+    else
+    {
+        for (uint32_t k = 0; k < node->group->num_members; k++)
+            RecordNode(node->group->members[k], beg, end);
+    }
+    ownUnlockMutex(&origin->lock);
+}
+
+// Runs a node, or the whole group it starts
+static vx_status ProcessUnit(vx_node node)
+{
+    const uint64_t beg = ownGetTimeNs();
+    vx_status status;
+    if (!node->group)
+    {
+        status = ownProcessNode(node);
+        node->status = status;
+    }
+    else
+    {
+        status = ownRunTileGroup(node->group);
+        for (uint32_t k = 0; k < node->group->num_members; k++)
+            node->group->members[k]->status = status;
+    }
+
+    // the arguments are copied, the message is formatted by the drain
+    if (status != VX_SUCCESS)
+        vxAddLogEntry((vx_reference)node, status, "%s: processing failed", node->kernel->name);
+
+    RecordUnit(node, beg, ownGetTimeNs());
+    return status;
+}
+
+// A graph that ran is timed from its start to the completion of its last node
+static void CompleteGraph(vx_graph graph, vx_status status, bool ran)
+{
+    // the graph may be released once it completes, so the pool goes first
+    ownDropThreadPool(graph->context, graph->pool);
+    graph->pool = NULL;
+
+    if (ran)
+    {
+        const uint64_t end = ownGetTimeNs();
+        ownLockMutex(&graph->origin->lock);
+        AddMeasurement(&graph->origin->perf, graph->started, end);
+        ownUnlockMutex(&graph->origin->lock);
+    }
+
+    ownLockMutex(&graph->lock);
+    graph->status = status;
+    graph->state = GRAPH_COMPLETED;
+    ownBroadcastCond(&graph->completed);
+    ownUnlockMutex(&graph->lock);
+}
+
+// The graph may be released as soon as it completes, so callers do not touch
+// it after counting down
+static void CountDown(vx_graph graph)
+{
+    if (ownAtomicAdd(&graph->remaining, -1) == 0)
+        CompleteGraph(graph, graph->run_status, true);
+}
+
+// Runs the node and releases its successors. One released successor is
+// returned so the calling thread continues with it instead of queueing it
+static vx_node RunNode(vx_node node)
+{
+    vx_graph graph = node->graph;
+
+    // after a failure the remaining nodes are skipped but still counted down
+    if (ownAtomicLoad(&graph->run_status) == VX_SUCCESS)
+    {
+        const vx_status status = ProcessUnit(node);
+        if (status != VX_SUCCESS)
+            ownAtomicCompareExchange(&graph->run_status, VX_SUCCESS, status);
+    }
+
+    vx_node next = NULL;
+    for (uint32_t i = 0; i < node->num_successors; i++)
+    {
+        vx_node successor = node->successors[i];
+        if (ownAtomicAdd(&successor->pending, -1) != 0)
+            continue;
+
+        if (!next)
+            next = successor;
+        else
+            SubmitNode(successor);
+    }
+
+    CountDown(graph);
+    return next;
+}
+
+static void NodeTask(void* arg)
+{
+    vx_node node = (vx_node)arg;
+    while (node)
+        node = RunNode(node);
+}
+
+static void SubmitNode(vx_node node)
+{
+    // without memory for the queue the node runs right here
+    if (!ownSubmitTask(node->graph->pool, NodeTask, node, node->graph))
+        NodeTask(node);
+}
+
+/*
+    Starts the graph. With a thread pool the nodes without dependencies are
+    queued, except the first one, which is returned in *first when the
+    caller is going to run it itself. Without a pool the nodes run on the
+    calling thread in the sorted order before the function returns.
+*/
+static vx_status StartGraph(vx_graph graph, vx_node* first)
+{
+    ownLockMutex(&graph->lock);
+    if (graph->state == GRAPH_RUNNING)
+    {
+        ownUnlockMutex(&graph->lock);
+        return VX_ERROR_GRAPH_SCHEDULED;
+    }
+    graph->state = GRAPH_RUNNING;
+    ownUnlockMutex(&graph->lock);
+
+    vx_status status = graph->verified ? VX_SUCCESS : VerifyGraph(graph);
+    if (status != VX_SUCCESS)
+    {
+        CompleteGraph(graph, status, false);
+        return status;
+    }
+
+    // a delay aged since the last run only moves the slot objects between nodes
+    BindDelays(graph);
+
+    graph->started = ownGetTimeNs();
+
+    graph->pool = ownAcquireThreadPool(graph->context);
+    if (!graph->pool)
+    {
+        for (uint32_t n = 0; n < graph->num_order && status == VX_SUCCESS; n++)
+        {
+            if (IsUnit(graph->order[n]))
+                status = ProcessUnit(graph->order[n]);
+        }
+        CompleteGraph(graph, status, true);
+        return VX_SUCCESS;
+    }
+
+    // the extra count keeps the graph running until every source is queued
+    graph->run_status = VX_SUCCESS;
+    graph->remaining = (int32_t)graph->num_units + 1;
+    for (uint32_t n = 0; n < graph->num_order; n++)
+        graph->order[n]->pending = (int32_t)graph->order[n]->num_predecessors;
+
+    vx_node caller_node = NULL;
+    for (uint32_t n = 0; n < graph->num_order; n++)
+    {
+        vx_node node = graph->order[n];
+        if (node->num_predecessors != 0 || !IsUnit(node))
+            continue;
+
+        if (first && !caller_node)
+            caller_node = node;
+        else
+            SubmitNode(node);
+    }
+
+    if (first)
+        *first = caller_node;
+    CountDown(graph);
+    return VX_SUCCESS;
+}
+
+// A graph with frames in flight must not be verified again: that would
+// release the copies running them
+static bool IsBusy(vx_graph graph)
+{
+    ownLockMutex(&graph->lock);
+    const bool busy = graph->state == GRAPH_RUNNING || graph->frame_count != 0;
+    ownUnlockMutex(&graph->lock);
+    return busy;
+}
+
+static vx_status WaitGraph(vx_graph graph)
+{
+    ownLockMutex(&graph->lock);
+    if (graph->state == GRAPH_IDLE)
+    {
+        ownUnlockMutex(&graph->lock);
+        return VX_FAILURE;
+    }
+    while (graph->state == GRAPH_RUNNING)
+        ownWaitCond(&graph->completed, &graph->lock);
+    graph->state = GRAPH_IDLE;
+    const vx_status status = graph->status;
+    ownUnlockMutex(&graph->lock);
+
+    // entries of the workers are handed to the callback on the application thread
+    ownFlushLog(graph->context);
+    return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+VX_API_ENTRY vx_graph VX_API_CALL vxCreateGraph(vx_context context)
+{
+    if (!context)
+        return NULL;
+
+    vx_graph graph = (vx_graph)calloc(1, sizeof(struct _vx_graph));
+    if (!graph)
+        return NULL;
+
+    graph->context = context;
+    graph->status = VX_SUCCESS;
+    graph->state = GRAPH_IDLE;
+    graph->pipeline_depth = 1;
+    graph->origin = graph;
+    ownInitMutex(&graph->lock);
+    ownInitCond(&graph->completed);
+    return graph;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseGraph(vx_graph *graph)
+{
+    if (!graph || !*graph)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    vx_graph g = *graph;
+
+    // a scheduled graph finishes before it is freed
+    ownLockMutex(&g->lock);
+    while (g->state == GRAPH_RUNNING)
+        ownWaitCond(&g->completed, &g->lock);
+    ownUnlockMutex(&g->lock);
+
+    ReleaseReplicas(g);
+    ownReleaseTileGroups(g);
+    ownReleaseFusedNodes(g);
+    for (uint32_t n = 0; n < g->num_nodes; n++)
+    {
+        DeinitializeNode(g->nodes[n]);
+        free(g->nodes[n]->successors);
+        free(g->nodes[n]);
+    }
+    for (uint32_t i = 0; i < g->num_virtuals; i++)
+        free(g->virtuals[i]);
+    ownAlignedFree(g->memory);
+    free(g->nodes);
+    free(g->order);
+    free(g->virtuals);
+    free(g->params);
+    free(g->param_uses);
+    free(g->delay_uses);
+    ownDestroyCond(&g->completed);
+    ownDestroyMutex(&g->lock);
+    free(g);
+
+    *graph = NULL;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    if (IsBusy(graph))
+        return VX_ERROR_GRAPH_SCHEDULED;
+
+    const vx_status status = VerifyGraph(graph);
+    ownFlushLog(graph->context);
+    return status;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxProcessGraph(vx_graph graph)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    // the calling thread runs a chain of nodes itself rather than sleeping;
+    // all buffers are in place and kernel temporaries come from the scratch
+    // arenas, which stop growing after the first frame
+    vx_node node = NULL;
+    const vx_status status = StartGraph(graph, &node);
+    if (status == VX_ERROR_GRAPH_SCHEDULED)
+        return status;
+
+    while (node)
+        node = RunNode(node);
+
+    return WaitGraph(graph);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxScheduleGraph(vx_graph graph)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    return StartGraph(graph, NULL);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxWaitGraph(vx_graph graph)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    return WaitGraph(graph);
+}
+
+VX_API_ENTRY vx_bool VX_API_CALL vxIsGraphVerified(vx_graph graph)
+{
+    return graph && graph->verified ? vx_true_e : vx_false_e;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryGraph(vx_graph graph, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_GRAPH_ATTRIBUTE_NUMNODES:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = graph->num_nodes;
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_STATUS:
+        if (size != sizeof(vx_status))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_status*)ptr = graph->status;
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_PERFORMANCE:
+        if (size != sizeof(vx_perf_t))
+            return VX_ERROR_INVALID_PARAMETERS;
+        ownLockMutex(&graph->lock);
+        *(vx_perf_t*)ptr = graph->perf;
+        ownUnlockMutex(&graph->lock);
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_NUMPARAMETERS:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = graph->num_params;
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_VIRTUAL_MEMORY_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = graph->memory_size;
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_VIRTUAL_MEMORY_SAVED_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = graph->memory_saved;
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH_EXT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = graph->pipeline_depth;
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_TILE_SIZE_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = graph->tile_size;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetGraphAttribute(vx_graph graph, vx_enum attribute, const void *ptr, vx_size size)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH_EXT:
+        if (size != sizeof(vx_uint32) || *(const vx_uint32*)ptr == 0)
+            return VX_ERROR_INVALID_PARAMETERS;
+        if (IsBusy(graph))
+            return VX_ERROR_GRAPH_SCHEDULED;
+        graph->pipeline_depth = *(const vx_uint32*)ptr;
+        graph->verified = 0;
+        return VX_SUCCESS;
+
+    case VX_GRAPH_ATTRIBUTE_TILE_SIZE_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        if (IsBusy(graph))
+            return VX_ERROR_GRAPH_SCHEDULED;
+        graph->tile_size = *(const vx_size*)ptr;
+        graph->verified = 0;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryNode(vx_node node, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!node)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_NODE_ATTRIBUTE_STATUS:
+        if (size != sizeof(vx_status))
+            return VX_ERROR_INVALID_PARAMETERS;
+        // a fused node reports for the nodes it runs
+        *(vx_status*)ptr = node->fused ? node->fused->status : node->status;
+        return VX_SUCCESS;
+
+    // the counters change while the graph runs
+    case VX_NODE_ATTRIBUTE_PERFORMANCE:
+        if (size != sizeof(vx_perf_t))
+            return VX_ERROR_INVALID_PARAMETERS;
+        ownLockMutex(&node->graph->lock);
+        *(vx_perf_t*)ptr = node->perf;
+        ownUnlockMutex(&node->graph->lock);
+        return VX_SUCCESS;
+
+    case VX_NODE_ATTRIBUTE_TARGET_EXT:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        // a fused member runs as part of its fused node
+        *(vx_enum*)ptr = node->fused ? node->fused->impl.target : node->impl.target;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+// Nodes belong to their graph and are freed with it
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseNode(vx_node *node)
+{
+    if (!node || !*node)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    *node = NULL;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_parameter VX_API_CALL vxGetParameterByIndex(vx_node node, vx_uint32 index)
+{
+    if (!node || index >= node->kernel->num_params)
+        return NULL;
+
+    vx_parameter parameter = (vx_parameter)malloc(sizeof(struct _vx_parameter));
+    if (!parameter)
+        return NULL;
+
+    parameter->node = node;
+    parameter->index = index;
+    return parameter;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryParameter(vx_parameter param, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!param)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    const vx_kernel kernel = param->node->kernel;
+    switch (attribute)
+    {
+    case VX_PARAMETER_ATTRIBUTE_INDEX:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = param->index;
+        return VX_SUCCESS;
+
+    case VX_PARAMETER_ATTRIBUTE_DIRECTION:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = kernel->directions[param->index];
+        return VX_SUCCESS;
+
+    case VX_PARAMETER_ATTRIBUTE_TYPE:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = kernel->types[param->index];
+        return VX_SUCCESS;
+
+    case VX_PARAMETER_ATTRIBUTE_STATE:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = VX_PARAMETER_STATE_REQUIRED;
+        return VX_SUCCESS;
+
+    // values are kept in the node and have no reference
+    case VX_PARAMETER_ATTRIBUTE_REF:
+        if (size != sizeof(vx_reference))
+            return VX_ERROR_INVALID_PARAMETERS;
+        if (!IsObjectType(kernel->types[param->index]))
+            return VX_ERROR_NOT_SUPPORTED;
+        *(vx_reference*)ptr = param->node->params[param->index];
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetParameterByIndex(vx_node node, vx_uint32 index, vx_reference value)
+{
+    if (!node || !value)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (index >= node->kernel->num_params || !IsObjectType(node->kernel->types[index]))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    vx_graph graph = node->graph;
+    const uint32_t node_index = FindNode(graph, node);
+
+    // the object of a graph parameter is replaced by vxSetGraphParameterByIndex
+    if (IsParameterUse(graph, node_index, index))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    // a virtual image can only connect nodes of the graph that created it
+    if (node->kernel->types[index] == VX_TYPE_IMAGE && ((vx_image)value)->scope && ((vx_image)value)->scope != graph)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    if (IsBusy(graph))
+        return VX_ERROR_GRAPH_SCHEDULED;
+
+    const vx_reference previous = node->params[index];
+    const uint32_t num_delay_uses = graph->num_delay_uses;
+    node->params[index] = value;
+
+    const vx_status status = AddDelayUse(graph, node_index, node, index);
+    if (status != VX_SUCCESS)
+    {
+        node->params[index] = previous;
+        return status;
+    }
+
+    // the slot of the previous object no longer applies; a new use comes last
+    RemoveDelayUse(graph, node_index, index, num_delay_uses);
+    graph->verified = 0;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetParameterByReference(vx_parameter parameter, vx_reference value)
+{
+    if (!parameter)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    return vxSetParameterByIndex(parameter->node, parameter->index, value);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseParameter(vx_parameter *param)
+{
+    if (!param || !*param)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    free(*param);
+    *param = NULL;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxAddParameterToGraph(vx_graph graph, vx_parameter parameter)
+{
+    if (!graph || !parameter)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    const vx_node node = parameter->node;
+    const vx_reference value = node->params[parameter->index];
+    if (node->graph != graph || !IsObjectType(node->kernel->types[parameter->index]))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    // the object of a delay slot changes with the delay, not with the frame
+    if (IsDelayUse(graph, node, parameter->index))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    // virtual images are replicated with the graph, they cannot come with a frame
+    if (node->kernel->types[parameter->index] == VX_TYPE_IMAGE && ((vx_image)value)->scope)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    for (uint32_t i = 0; i < graph->num_params; i++)
+    {
+        if (GetParameterValue(graph, i) == value)
+            return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (IsBusy(graph))
+        return VX_ERROR_GRAPH_SCHEDULED;
+
+    const uint32_t count = graph->num_params;
+    struct _vx_parameter* grown = (struct _vx_parameter*)realloc(graph->params, ((size_t)count + 1) * sizeof(struct _vx_parameter));
+    if (!grown)
+        return VX_ERROR_NO_MEMORY;
+    grown[count] = *parameter;
+    graph->params = grown;
+
+    const uint32_t num_param_uses = graph->num_param_uses;
+    vx_status status = VX_SUCCESS;
+    for (uint32_t n = 0; n < graph->num_nodes && status == VX_SUCCESS; n++)
+        status = AddParameterUses(graph, count, n, graph->nodes[n]);
+
+    if (status != VX_SUCCESS)
+    {
+        graph->num_param_uses = num_param_uses;
+        return status;
+    }
+
+    graph->num_params++;
+    graph->verified = 0;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetGraphParameterByIndex(vx_graph graph, vx_uint32 index, vx_reference value)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (index >= graph->num_params)
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (IsBusy(graph))
+        return VX_ERROR_GRAPH_SCHEDULED;
+
+    bool same_layout;
+    const vx_status status = CheckParameterValue(graph, index, value, &same_layout);
+    if (status != VX_SUCCESS)
+        return status;
+
+    for (uint32_t i = 0; i < graph->num_params; i++)
+    {
+        if (i != index && GetParameterValue(graph, i) == value)
+            return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    BindParameter(graph, index, value);
+    if (!same_layout)
+        graph->verified = 0;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_parameter VX_API_CALL vxGetGraphParameterByIndex(vx_graph graph, vx_uint32 index)
+{
+    if (!graph || index >= graph->num_params)
+        return NULL;
+
+    return vxGetParameterByIndex(graph->params[index].node, graph->params[index].index);
+}
+
+/*
+    Frames run on the copies of the graph in turn. A copy is free again once
+    its frame is dequeued, so at most pipeline_depth frames are in flight and
+    every node of a frame runs as soon as its inputs are ready, whatever the
+    other frames are doing: with enough threads the graph delivers a frame
+    per run of its slowest node rather than per run of the whole graph.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxEnqueueGraphFrameExt(vx_graph graph, const vx_reference refs[], vx_uint32 num_refs)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (num_refs != graph->num_params || (!refs && num_refs != 0))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    vx_status status = VX_SUCCESS;
+    if (!graph->verified)
+    {
+        if (IsBusy(graph))
+            return VX_ERROR_GRAPH_SCHEDULED;
+        status = VerifyGraph(graph);
+        if (status != VX_SUCCESS)
+            return status;
+    }
+
+    ownLockMutex(&graph->lock);
+    const uint32_t depth = graph->num_replicas + 1;
+    const uint32_t count = graph->frame_count;
+    const uint32_t slot = (graph->frame_head + count) % depth;
+    ownUnlockMutex(&graph->lock);
+
+    if (count == depth)
+        return VX_ERROR_NO_RESOURCES;
+
+    for (uint32_t i = 0; i < num_refs && status == VX_SUCCESS; i++)
+    {
+        bool same_layout;
+        status = CheckParameterValue(graph, i, refs[i], &same_layout);
+        if (status == VX_SUCCESS && !same_layout)
+            status = VX_ERROR_INVALID_PARAMETERS;
+
+        for (uint32_t j = 0; j < i && status == VX_SUCCESS; j++)
+        {
+            if (refs[j] == refs[i])
+                status = VX_ERROR_INVALID_PARAMETERS;
+        }
+    }
+    if (status != VX_SUCCESS)
+        return status;
+
+    vx_graph frame = slot == 0 ? graph : graph->replicas[slot - 1];
+
+    // the first copy is the graph itself and may have been scheduled directly
+    ownLockMutex(&frame->lock);
+    const bool running = frame->state == GRAPH_RUNNING;
+    ownUnlockMutex(&frame->lock);
+    if (running)
+        return VX_ERROR_GRAPH_SCHEDULED;
+
+    for (uint32_t i = 0; i < num_refs; i++)
+    {
+        BindParameter(frame, i, refs[i]);
+        graph->frame_refs[(size_t)slot * num_refs + i] = refs[i];
+    }
+
+    status = StartGraph(frame, NULL);
+    if (status != VX_SUCCESS)
+    {
+        if (status != VX_ERROR_GRAPH_SCHEDULED)
+            WaitGraph(frame);
+        return status;
+    }
+
+    ownLockMutex(&graph->lock);
+    graph->frame_count++;
+    ownUnlockMutex(&graph->lock);
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxDequeueGraphFrameExt(vx_graph graph, vx_reference refs[], vx_uint32 num_refs)
+{
+    if (!graph)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (refs && num_refs != graph->num_params)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    ownLockMutex(&graph->lock);
+    const uint32_t count = graph->frame_count;
+    const uint32_t slot = graph->frame_head;
+    ownUnlockMutex(&graph->lock);
+
+    if (count == 0)
+        return VX_FAILURE;
+
+    const vx_status status = WaitGraph(slot == 0 ? graph : graph->replicas[slot - 1]);
+    if (refs)
+        memcpy(refs, &graph->frame_refs[(size_t)slot * num_refs], num_refs * sizeof(vx_reference));
+
+    ownLockMutex(&graph->lock);
+    graph->frame_head = (slot + 1) % (graph->num_replicas + 1);
+    graph->frame_count--;
+    ownUnlockMutex(&graph->lock);
+    return status;
+}
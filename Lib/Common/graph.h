@@ -0,0 +1,607 @@
+/*
+    File: graph.h
+    Содержит внутреннее представление графов, узлов и ядер OpenVX.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __GRAPH_H__
+#define __GRAPH_H__
+
+#include "types.h"
+#include "vx_ext.h"
+#include "platform.h"
+#include "parallel.h"
+#include "lut.h"
+
+/*
+    Constant: OWN_MAX_KERNEL_PARAMS
+    Максимальное количество параметров ядра.
+*/
+#define OWN_MAX_KERNEL_PARAMS 5
+
+/*
+    Constant: OWN_MAX_KERNEL_IMPLS
+    Максимальное количество реализаций ядра.
+*/
+#define OWN_MAX_KERNEL_IMPLS 8
+
+/*
+    Type: own_kernel_validate_f
+    Проверяет параметры узла перед исполнением графа: форматы и размеры
+    входных изображений, значения параметров. Для выходных виртуальных
+    изображений с незаданными размерами или форматом (VX_DF_IMAGE_VIRT)
+    функция задаёт их по входным изображениям.
+*/
+typedef vx_status (*own_kernel_validate_f)(vx_node node);
+
+/*
+    Type: own_kernel_process_f
+    Исполняет узел над его параметрами.
+*/
+typedef vx_status (*own_kernel_process_f)(vx_node node);
+
+/*
+    Type: own_kernel_halo_f
+    Возвращает, на сколько строк выше и ниже строки выходного изображения
+    узел читает входные изображения.
+*/
+typedef uint32_t (*own_kernel_halo_f)(vx_node node);
+
+/*
+    Structure: own_pixel_op
+    Операция над 8-битными пикселями, которую узел выполняет над каждым
+    пикселем независимо от соседей.
+*/
+typedef struct
+{
+    //Variable: code
+    //операция (OWN_PIXEL_*);
+    uint32_t code;
+    //Variable: table
+    //таблица для OWN_PIXEL_TABLE.
+    uint8_t table[OWN_LUT8_SIZE];
+} own_pixel_op;
+
+/*
+    Constants: OWN_PIXEL_*
+    Операции <own_pixel_op>.
+
+    OWN_PIXEL_TABLE - dst = table[src] для единственного входного изображения;
+    OWN_PIXEL_AND   - dst = src1 & src2;
+    OWN_PIXEL_OR    - dst = src1 | src2;
+    OWN_PIXEL_XOR   - dst = src1 ^ src2.
+*/
+#define OWN_PIXEL_TABLE 0
+#define OWN_PIXEL_AND   1
+#define OWN_PIXEL_OR    2
+#define OWN_PIXEL_XOR   3
+
+/*
+    Type: own_kernel_pixel_f
+    Описывает узел как операцию над 8-битными пикселями с текущими
+    значениями его параметров (порога, таблицы).
+
+    Return:
+        false, если узел нельзя выразить такой операцией (например, формат
+        изображений не VX_DF_IMAGE_U8).
+*/
+typedef bool (*own_kernel_pixel_f)(vx_node node, own_pixel_op* op);
+
+/*
+    Structure: own_kernel_impl
+    Реализация ядра. Узел исполняется с маской <ownSetCpuFeatureMask>,
+    соответствующей target, поэтому функции библиотеки, которые выбирают
+    SIMD-версию во время исполнения, используют не более новый набор
+    инструкций.
+*/
+typedef struct
+{
+    //Variable: target
+    //реализация <vx_target_ext_e>;
+    vx_enum target;
+    //Variable: priority
+    //приоритет: узел получает доступную реализацию с наибольшим приоритетом;
+    uint32_t priority;
+    //Variable: features
+    //наборы инструкций <vx_cpu_feature_e>, которые нужны реализации;
+    uint32_t features;
+    //Variable: process
+    //функция исполнения реализации библиотеки или NULL;
+    own_kernel_process_f process;
+    //Variable: function
+    //функция исполнения, добавленная приложением, или NULL.
+    vx_kernel_f function;
+} own_kernel_impl;
+
+/*
+    Structure: _vx_kernel
+    Описание функции, которую может исполнять узел графа. Ядра библиотеки
+    описаны статически, ядра <vxAddKernel> принадлежат контексту.
+*/
+struct _vx_kernel
+{
+    //Variable: enumeration
+    //идентификатор ядра (<vx_kernel_e> или VX_KERNEL_*_EXT);
+    vx_enum enumeration;
+    //Variable: name
+    //имя ядра;
+    const char* name;
+    //Variable: num_params
+    //количество параметров;
+    uint32_t num_params;
+    //Variable: directions
+    //направления параметров (VX_INPUT или VX_OUTPUT);
+    vx_enum directions[OWN_MAX_KERNEL_PARAMS];
+    //Variable: types
+    //типы параметров: VX_TYPE_IMAGE, VX_TYPE_THRESHOLD, VX_TYPE_LUT - объекты,
+    //VX_TYPE_INT32, VX_TYPE_UINT32, VX_TYPE_ENUM - значения, хранящиеся в узле;
+    vx_enum types[OWN_MAX_KERNEL_PARAMS];
+    //Variable: validate
+    //функция проверки параметров;
+    own_kernel_validate_f validate;
+    //Variable: impls
+    //реализации в порядке добавления (изменяются под kernel_lock контекста);
+    own_kernel_impl impls[OWN_MAX_KERNEL_IMPLS];
+    //Variable: num_impls
+    //количество реализаций;
+    uint32_t num_impls;
+    //Variable: deinitialize
+    //функция освобождения ресурсов, которые узел получил при проверке, или NULL;
+    own_kernel_process_f deinitialize;
+    //Variable: halo
+    //функция размера окрестности; NULL, если выходное изображение нельзя
+    //вычислять по полосам строк (например, ядро использует гистограмму);
+    own_kernel_halo_f halo;
+    //Variable: pixel
+    //функция описания узла как поэлементной операции или NULL;
+    own_kernel_pixel_f pixel;
+    //Variable: next
+    //следующее ядро контекста, добавленное <vxAddKernel>.
+    vx_kernel next;
+};
+
+/*
+    Structure: own_tile_group
+    Группа узлов, идущих подряд в порядке исполнения, которые исполняются
+    по полосам строк: полоса проходит через все узлы группы, прежде чем
+    начинается следующая. Виртуальные изображения, которые читают только
+    узлы группы, существуют лишь в виде полос в памяти потока и никогда не
+    размещаются целиком.
+*/
+typedef struct _own_tile_group
+{
+    //Variable: members
+    //узлы группы в порядке исполнения;
+    vx_node* members;
+    //Variable: flags
+    //признаки выходных изображений узлов (OWN_TILE_*);
+    uint32_t* flags;
+    //Variable: num_members
+    //количество узлов;
+    uint32_t num_members;
+    //Variable: first
+    //номер первого узла группы в порядке исполнения;
+    uint32_t first;
+    //Variable: last
+    //номер последнего узла группы в порядке исполнения;
+    uint32_t last;
+    //Variable: height
+    //высота изображений группы;
+    uint32_t height;
+    //Variable: band_rows
+    //высота полосы;
+    uint32_t band_rows;
+    //Variable: band_bytes
+    //объём данных, которые обрабатывает полоса.
+    size_t band_bytes;
+} own_tile_group;
+
+/*
+    Constants: OWN_TILE_*
+    Признаки выходного изображения узла группы.
+
+    OWN_TILE_BUFFERED - узел записывает полосу в память потока, потому что
+                        следующим узлам нужны строки за пределами полосы или
+                        изображение не размещается целиком;
+    OWN_TILE_EXTERNAL - изображение размещается целиком: его читают узлы вне
+                        группы или оно не виртуальное.
+*/
+#define OWN_TILE_BUFFERED 0x1
+#define OWN_TILE_EXTERNAL 0x2
+
+/*
+    Structure: _vx_node
+    Узел графа: ядро и его параметры. Узел принадлежит графу и
+    освобождается вместе с ним.
+*/
+struct _vx_node
+{
+    //Variable: graph
+    //граф узла;
+    vx_graph graph;
+    //Variable: kernel
+    //ядро узла;
+    vx_kernel kernel;
+    //Variable: impl
+    //реализация ядра, выбранная при проверке графа (см. <ownSelectKernelImpl>);
+    own_kernel_impl impl;
+    //Variable: initialized
+    //1, если узел получил ресурсы при проверке и должен их освободить
+    //(см. <_vx_kernel>::deinitialize);
+    uint32_t initialized;
+    //Variable: params
+    //объекты, передаваемые ядру (NULL для параметров-значений и для
+    //незаданных параметров узла <vxCreateGenericNode>);
+    vx_reference params[OWN_MAX_KERNEL_PARAMS];
+    //Variable: values
+    //значения параметров типов VX_TYPE_INT32, VX_TYPE_UINT32 и VX_TYPE_ENUM;
+    vx_int32 values[OWN_MAX_KERNEL_PARAMS];
+    //Variable: status
+    //результат последнего исполнения узла;
+    vx_status status;
+    //Variable: successors
+    //узлы, которые зависят от этого узла (заполняется при проверке графа);
+    vx_node* successors;
+    //Variable: num_successors
+    //количество зависимых узлов;
+    uint32_t num_successors;
+    //Variable: num_predecessors
+    //количество узлов, от которых зависит этот узел;
+    uint32_t num_predecessors;
+    //Variable: pending
+    //количество незавершённых узлов, от которых зависит узел, при исполнении;
+    volatile int32_t pending;
+    //Variable: group
+    //группа исполнения по полосам или NULL;
+    own_tile_group* group;
+    //Variable: halo
+    //сколько строк выше и ниже полосы узел читает во входных изображениях;
+    uint32_t halo;
+    //Variable: extent
+    //на сколько строк выше и ниже полосы узел должен вычислить выходное
+    //изображение для следующих узлов группы;
+    uint32_t extent;
+    //Variable: fused
+    //узел слияния, который исполняет этот узел, или NULL; у самого узла
+    //слияния - он сам;
+    vx_node fused;
+    //Variable: origin
+    //узел, который ведёт счётчики времени исполнения: сам узел или, в копии
+    //графа для потокового исполнения, соответствующий узел исходного графа;
+    vx_node origin;
+    //Variable: perf
+    //время исполнения узла в наносекундах (изменяется под lock графа узла
+    //origin). Узел, исполняемый в составе узла слияния или группы, получает
+    //время всего узла слияния или группы.
+    vx_perf_t perf;
+};
+
+/*
+    Structure: _vx_parameter
+    Параметр узла: узел и номер его параметра.
+*/
+struct _vx_parameter
+{
+    //Variable: node
+    //узел;
+    vx_node node;
+    //Variable: index
+    //номер параметра узла.
+    uint32_t index;
+};
+
+/*
+    Structure: own_parameter_use
+    Место, где граф использует объект параметра графа. Объект параметра
+    подставляется во все такие места, а не только в параметр узла, через
+    который он добавлен.
+*/
+typedef struct
+{
+    //Variable: param
+    //номер параметра графа;
+    uint32_t param;
+    //Variable: node
+    //номер узла в порядке добавления;
+    uint32_t node;
+    //Variable: index
+    //номер параметра узла.
+    uint32_t index;
+} own_parameter_use;
+
+/*
+    Structure: own_delay_use
+    Параметр узла, связанный со слотом задержки. При запуске графа в него
+    подставляется объект, который слот хранит в этот момент, поэтому
+    <vxAgeDelay> не требует ни копирования, ни повторной проверки графа.
+*/
+typedef struct
+{
+    //Variable: delay
+    //задержка;
+    vx_delay delay;
+    //Variable: slot
+    //номер слота (от -(count-1) до 0);
+    int32_t slot;
+    //Variable: node
+    //номер узла в порядке добавления;
+    uint32_t node;
+    //Variable: index
+    //номер параметра узла.
+    uint32_t index;
+} own_delay_use;
+
+/*
+    Structure: _vx_graph
+    Граф: узлы, связанные общими изображениями и другими объектами. Узел,
+    читающий объект, исполняется после узла, который его записывает.
+
+    <vxVerifyGraph> упорядочивает узлы, проверяет параметры и выделяет память
+    виртуальных изображений, поэтому <vxProcessGraph> только исполняет узлы.
+    Узел исполняется на пуле потоков контекста, как только завершены узлы,
+    от которых он зависит, поэтому независимые узлы исполняются параллельно.
+    <vxScheduleGraph> возвращает управление сразу, и одновременно могут
+    исполняться несколько графов.
+    Виртуальное изображение нужно от записывающего его узла до последнего
+    читающего, и изображения, время жизни которых не пересекается,
+    размещаются в общей памяти графа по одному адресу.
+
+    При потоковом исполнении (<vxEnqueueGraphFrameExt>) граф копируется
+    для каждого из pipeline_depth одновременно исполняемых кадров: копии
+    имеют свои узлы и виртуальные изображения, а кадры отличаются объектами,
+    подставленными в параметры графа. Копия с номером 0 - сам граф.
+
+    Параметры узлов, связанные со слотами задержек (<own_delay_use>),
+    получают объекты слотов при каждом запуске графа или кадра.
+
+    Идущие подряд поэлементные узлы (см. <own_kernel_pixel_f>) сливаются
+    при проверке в один узел, который заменяет их в порядке исполнения:
+    каждый пиксель читается и записывается один раз, а виртуальные
+    изображения между ними не размещаются (см. <ownFuseNodes>).
+
+    Если задан VX_GRAPH_ATTRIBUTE_TILE_SIZE_EXT, узлы, которые можно
+    исполнять по полосам строк, объединяются в группы <own_tile_group>, и
+    группа исполняется как один узел.
+*/
+struct _vx_graph
+{
+    //Variable: context
+    //контекст графа;
+    vx_context context;
+    //Variable: nodes
+    //узлы в порядке добавления;
+    vx_node* nodes;
+    //Variable: num_nodes
+    //количество узлов;
+    uint32_t num_nodes;
+    //Variable: order
+    //узлы в порядке исполнения (заполняется при проверке графа);
+    vx_node* order;
+    //Variable: num_order
+    //количество узлов в порядке исполнения: после слияния меньше num_nodes;
+    uint32_t num_order;
+    //Variable: virtuals
+    //виртуальные изображения графа;
+    vx_image* virtuals;
+    //Variable: num_virtuals
+    //количество виртуальных изображений;
+    uint32_t num_virtuals;
+    //Variable: memory
+    //общая память виртуальных изображений (выделяется при проверке графа);
+    void* memory;
+    //Variable: memory_size
+    //размер общей памяти в байтах;
+    size_t memory_size;
+    //Variable: memory_saved
+    //на сколько байт общая память меньше суммы размеров виртуальных изображений;
+    size_t memory_saved;
+    //Variable: status
+    //результат последней проверки или исполнения графа;
+    vx_status status;
+    //Variable: verified
+    //1, если граф проверен и не изменялся после проверки;
+    uint32_t verified;
+    //Variable: pool
+    //пул потоков, на котором исполняется граф (взят <ownAcquireThreadPool> до завершения исполнения);
+    own_thread_pool pool;
+    //Variable: lock
+    //блокировка состояния исполнения;
+    own_mutex_t lock;
+    //Variable: completed
+    //сигнализируется, когда исполнение графа завершено;
+    own_cond_t completed;
+    //Variable: perf
+    //время исполнения графа в наносекундах от запуска после проверки до
+    //завершения последнего узла (изменяется под lock);
+    vx_perf_t perf;
+    //Variable: started
+    //время запуска текущего исполнения;
+    uint64_t started;
+    //Variable: state
+    //состояние исполнения: не запущен, исполняется, завершён;
+    uint32_t state;
+    //Variable: remaining
+    //количество незавершённых узлов при исполнении;
+    volatile int32_t remaining;
+    //Variable: run_status
+    //первая ошибка узла при исполнении;
+    volatile int32_t run_status;
+    //Variable: params
+    //параметры графа;
+    struct _vx_parameter* params;
+    //Variable: num_params
+    //количество параметров графа;
+    uint32_t num_params;
+    //Variable: param_uses
+    //места, где используются объекты параметров графа;
+    own_parameter_use* param_uses;
+    //Variable: num_param_uses
+    //количество мест;
+    uint32_t num_param_uses;
+    //Variable: delay_uses
+    //параметры узлов, связанные со слотами задержек;
+    own_delay_use* delay_uses;
+    //Variable: num_delay_uses
+    //количество таких параметров;
+    uint32_t num_delay_uses;
+    //Variable: pipeline_depth
+    //сколько кадров может исполняться одновременно;
+    uint32_t pipeline_depth;
+    //Variable: replicas
+    //копии графа для кадров 1..pipeline_depth-1 (создаются при проверке графа);
+    vx_graph* replicas;
+    //Variable: num_replicas
+    //количество копий;
+    uint32_t num_replicas;
+    //Variable: frame_refs
+    //объекты параметров запущенных кадров, num_params на каждую копию;
+    vx_reference* frame_refs;
+    //Variable: frame_head
+    //копия, исполняющая самый ранний незабранный кадр;
+    uint32_t frame_head;
+    //Variable: frame_count
+    //количество запущенных и незабранных кадров;
+    uint32_t frame_count;
+    //Variable: tile_size
+    //объём данных, обрабатываемых полосой группы, в байтах (0 - без групп);
+    size_t tile_size;
+    //Variable: groups
+    //группы исполнения по полосам (создаются при проверке графа);
+    own_tile_group** groups;
+    //Variable: num_groups
+    //количество групп;
+    uint32_t num_groups;
+    //Variable: num_units
+    //количество узлов, исполняемых отдельно, с учётом группы как одного узла;
+    uint32_t num_units;
+    //Variable: fused
+    //узлы слияния (создаются при проверке графа);
+    vx_node* fused;
+    //Variable: num_fused
+    //количество узлов слияния;
+    uint32_t num_fused;
+    //Variable: origin
+    //граф, который ведёт счётчики времени исполнения: сам граф или исходный
+    //граф для его копии.
+    vx_graph origin;
+};
+
+/*
+    Function: ownCreateNode
+    Создаёт узел графа и проверяет типы переданных параметров: объекты
+    передаются в refs, значения - в values (см. <_vx_kernel>). Если refs
+    равен NULL, объекты задаются позже <vxSetParameterByIndex>. После
+    добавления узла граф нужно проверить заново.
+
+    Return:
+        Узел или NULL, если параметр не задан или не удалось выделить память.
+*/
+vx_node ownCreateNode(vx_graph graph, vx_kernel kernel, const vx_reference* refs, const vx_int32* values);
+
+/*
+    Function: ownAddVirtualImage
+    Делает изображение виртуальным изображением графа: память для него
+    назначается при проверке графа, освобождается изображение вместе с графом.
+*/
+vx_status ownAddVirtualImage(vx_graph graph, vx_image image);
+
+/*
+    Function: ownFuseNodes
+    Заменяет в порядке исполнения проверенного графа цепочки идущих подряд
+    поэлементных узлов одного размера узлами слияния. Узел слияния читает
+    строку входных изображений по частям, которые помещаются в кэш, и
+    проводит каждую часть через все операции цепочки; подряд идущие
+    табличные операции сворачиваются в одну таблицу. Параметры узла
+    слияния - объекты, которые цепочка читает извне, и изображения, которые
+    нужны вне её, поэтому их не больше <OWN_MAX_KERNEL_PARAMS>.
+*/
+vx_status ownFuseNodes(vx_graph graph);
+
+/*
+    Function: ownReleaseFusedNodes
+    Освобождает узлы слияния графа.
+*/
+void ownReleaseFusedNodes(vx_graph graph);
+
+/*
+    Function: ownBindFusedParams
+    Переносит в параметры узлов слияния объекты, подставленные в параметры
+    исходных узлов (см. <vxSetGraphParameterByIndex>).
+*/
+void ownBindFusedParams(vx_graph graph);
+
+/*
+    Function: ownGetFusedMembers
+    Возвращает узлы, которые исполняет узел слияния, и записывает их
+    количество в *count.
+*/
+const vx_node* ownGetFusedMembers(const vx_node node, uint32_t* count);
+
+/*
+    Function: ownIsFusedInternal
+    Проверяет, что изображение существует только внутри узла слияния,
+    поэтому не размещается.
+*/
+bool ownIsFusedInternal(const vx_graph graph, const vx_image image);
+
+/*
+    Function: ownFormTileGroups
+    Объединяет узлы проверенного и упорядоченного графа в группы исполнения
+    по полосам, если задан размер полосы, и вычисляет высоту полос.
+*/
+vx_status ownFormTileGroups(vx_graph graph);
+
+/*
+    Function: ownReleaseTileGroups
+    Освобождает группы графа.
+*/
+void ownReleaseTileGroups(vx_graph graph);
+
+/*
+    Function: ownIsTileInternal
+    Проверяет, что виртуальное изображение записывает и читает только одна
+    группа, поэтому оно не размещается целиком.
+*/
+bool ownIsTileInternal(const vx_graph graph, const vx_image image);
+
+/*
+    Function: ownRunTileGroup
+    Исполняет узлы группы по полосам на пуле потоков.
+
+    Return:
+        Первая ошибка узла или VX_SUCCESS.
+*/
+vx_status ownRunTileGroup(own_tile_group* group);
+
+/*
+    Function: ownGetLibraryKernel
+    Возвращает описание ядра библиотеки по идентификатору или NULL, если
+    такого ядра нет.
+*/
+vx_kernel ownGetLibraryKernel(vx_enum kernel);
+
+/*
+    Function: ownSelectKernelImpl
+    Выбирает реализацию ядра узла (<_vx_node>::impl): реализацию
+    VX_CONTEXT_ATTRIBUTE_TARGET_EXT, если она есть у ядра и поддерживается
+    процессором, иначе доступную реализацию с наибольшим приоритетом.
+
+    Return:
+        VX_SUCCESS или VX_ERROR_NOT_SUPPORTED, если процессор не поддерживает
+        ни одну реализацию ядра.
+*/
+vx_status ownSelectKernelImpl(vx_node node);
+
+/*
+    Function: ownProcessNode
+    Исполняет узел на выбранной реализации ядра.
+*/
+vx_status ownProcessNode(vx_node node);
+
+/*
+    Function: ownReleaseKernels
+    Удаляет ядра и реализации, добавленные приложением в контекст.
+*/
+void ownReleaseKernels(vx_context context);
+
+#endif // __GRAPH_H__
@@ -0,0 +1,679 @@
+/*
+    File: image.c
+    Содержит вспомогательные функции для работы с изображениями.
+
+    Date: 18 Октября 2026
+*/
+
+#include "image.h"
+#include "context.h"
+#include "graph.h"
+#include "parallel.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+size_t ownGetRowSize(vx_df_image format, uint32_t width)
+{
+    if (format == VX_DF_IMAGE_U1_EXT)
+        return ((size_t)width + 63) / 64 * sizeof(uint64_t);
+
+    return (size_t)ownGetPixelSize(format) * width;
+}
+
+uint32_t ownGetPixelSize(vx_df_image format)
+{
+    switch (format)
+    {
+    case VX_DF_IMAGE_U8:
+        return 1;
+    case VX_DF_IMAGE_U16:
+    case VX_DF_IMAGE_S16:
+    case VX_DF_IMAGE_UYVY:
+    case VX_DF_IMAGE_YUYV:
+        return 2;
+    case VX_DF_IMAGE_RGB:
+        return 3;
+    case VX_DF_IMAGE_U32:
+    case VX_DF_IMAGE_S32:
+    case VX_DF_IMAGE_RGBX:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+size_t ownGetImageSize(const vx_image image)
+{
+    return ownGetRowSize(image->image_type, image->width) * image->height;
+}
+
+uint32_t ownGetNumPlanes(const vx_image image)
+{
+    return image->num_planes > 1 ? image->num_planes : 1;
+}
+
+vx_image ownGetPlane(const vx_image image, uint32_t plane)
+{
+    return image->num_planes > 1 ? &image->planes[plane] : image;
+}
+
+int32_t ownGetStrideX(const vx_image image)
+{
+    return image->stride_x ? image->stride_x : (int32_t)ownGetPixelSize(image->image_type);
+}
+
+int32_t ownGetStrideY(const vx_image image)
+{
+    return image->stride_y ? image->stride_y : (int32_t)ownGetRowSize(image->image_type, image->width);
+}
+
+bool ownCheckStrides(const vx_image image)
+{
+    const uint32_t pixel_size = ownGetPixelSize(image->image_type);
+    const int32_t stride_x = ownGetStrideX(image);
+    const int32_t stride_y = ownGetStrideY(image);
+
+    if (image->image_type == VX_DF_IMAGE_U1_EXT)
+        return image->stride_x == 0 && stride_y % (int32_t)sizeof(uint64_t) == 0;
+
+    if (stride_x < (int32_t)pixel_size || pixel_size == 0)
+        return false;
+
+    // rows may go bottom-up, but must not overlap
+    const size_t row_span = (size_t)stride_x * (image->width ? image->width - 1 : 0) + pixel_size;
+    return image->height <= 1 || (size_t)(stride_y < 0 ? -stride_y : stride_y) >= row_span;
+}
+
+bool ownIsRowDense(const vx_image image)
+{
+    return image->image_type == VX_DF_IMAGE_U1_EXT || ownGetStrideX(image) == (int32_t)ownGetPixelSize(image->image_type);
+}
+
+const void* ownLoadRow(const vx_image image, uint32_t y, void* buffer)
+{
+    const uint8_t* row = ownGetPixelPtr(image, 0, y);
+    if (ownIsRowDense(image))
+        return row;
+
+    const uint32_t pixel_size = ownGetPixelSize(image->image_type);
+    const int32_t stride_x = ownGetStrideX(image);
+    uint8_t* dst = (uint8_t*)buffer;
+
+    for (uint32_t x = 0; x < image->width; x++)
+        memcpy(dst + (size_t)x * pixel_size, row + (ptrdiff_t)x * stride_x, pixel_size);
+
+    return buffer;
+}
+
+void* ownGetRowOutput(vx_image image, uint32_t y, void* buffer)
+{
+    return ownIsRowDense(image) ? ownGetPixelPtr(image, 0, y) : buffer;
+}
+
+void ownStoreRow(vx_image image, uint32_t y, const void* row)
+{
+    uint8_t* dst = ownGetPixelPtr(image, 0, y);
+    if (row == dst)
+        return;
+
+    const uint32_t pixel_size = ownGetPixelSize(image->image_type);
+    const int32_t stride_x = ownGetStrideX(image);
+    const uint8_t* src = (const uint8_t*)row;
+
+    for (uint32_t x = 0; x < image->width; x++)
+        memcpy(dst + (ptrdiff_t)x * stride_x, src + (size_t)x * pixel_size, pixel_size);
+}
+
+size_t ownGetAlignment(const vx_image image)
+{
+    const int32_t stride_y = ownGetStrideY(image);
+    size_t bits = (size_t)image->data | 4096;
+    if (image->height > 1)
+        bits |= (size_t)(stride_y < 0 ? -stride_y : stride_y);
+
+    // lowest set bit
+    return bits & (~bits + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    vx_image images[OWN_MAP_MAX_SRC + 1]; // inputs, then the output
+    uint32_t num_images;
+    uint32_t row_count;
+    uint32_t merge_rows;
+    own_row_f func;
+    const void* params;
+    volatile int32_t out_of_memory;
+} MapArgs;
+
+static bool CanMergeRows(const vx_image image)
+{
+    // rows follow each other without gaps and no padding bits sit between them
+    return ownIsRowDense(image) &&
+           ownGetStrideY(image) == (int32_t)ownGetRowSize(image->image_type, image->width) &&
+           (image->image_type != VX_DF_IMAGE_U1_EXT || image->width % 64 == 0);
+}
+
+static void ClearPackedPadding(uint8_t* row, uint32_t width)
+{
+    const size_t used = ((size_t)width + 7) / 8;
+    if (width % 8)
+        row[used - 1] &= (uint8_t)((1u << (width % 8)) - 1);
+    memset(row + used, 0, ownGetRowSize(VX_DF_IMAGE_U1_EXT, width) - used);
+}
+
+static void MapRows(void* data, uint32_t y_begin, uint32_t y_end)
+{
+    MapArgs* args = (MapArgs*)data;
+    const uint32_t num_src = args->num_images - 1;
+    vx_image dst_image = args->images[num_src];
+    const uint32_t width = dst_image->width;
+
+    const void* src[OWN_MAP_MAX_SRC];
+
+    if (args->merge_rows)
+    {
+        for (uint32_t i = 0; i < num_src; i++)
+            src[i] = ownGetPixelPtr(args->images[i], 0, y_begin);
+        args->func(src, ownGetPixelPtr(dst_image, 0, y_begin), (y_end - y_begin) * width, args->params);
+        return;
+    }
+
+    own_arena arena = ownGetScratchArena();
+    const size_t arena_mark = ownArenaMark(arena);
+    void* buffers[OWN_MAP_MAX_SRC + 1] = { NULL };
+    bool failed = false;
+
+    for (uint32_t i = 0; i < args->num_images; i++)
+    {
+        if (!ownIsRowDense(args->images[i]))
+        {
+            buffers[i] = ownArenaAlloc(arena, ownGetRowSize(args->images[i]->image_type, width));
+            failed = failed || !buffers[i];
+        }
+    }
+
+    for (uint32_t y = y_begin; y < y_end && !failed; y++)
+    {
+        for (uint32_t i = 0; i < num_src; i++)
+            src[i] = ownLoadRow(args->images[i], y, buffers[i]);
+
+        void* dst = ownGetRowOutput(dst_image, y, buffers[num_src]);
+        args->func(src, dst, args->row_count, args->params);
+
+        if (dst_image->image_type == VX_DF_IMAGE_U1_EXT)
+            ClearPackedPadding((uint8_t*)dst, width);
+        ownStoreRow(dst_image, y, dst);
+    }
+
+    if (failed)
+        args->out_of_memory = 1;
+
+    ownArenaReset(arena, arena_mark);
+}
+
+vx_status ownMapRows(const vx_image* src_images, uint32_t num_src, vx_image dst_image, own_row_f func, const void* params)
+{
+    if (num_src > OWN_MAP_MAX_SRC)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    MapArgs args;
+    args.num_images = num_src + 1;
+    args.merge_rows = 1;
+    args.func = func;
+    args.params = params;
+    args.out_of_memory = 0;
+
+    const uint32_t width = dst_image->width;
+    size_t row_bytes = 0;
+
+    // rows are extended into the padding so that vector loops need no tail
+    size_t row_count = ((size_t)width + OWN_IMAGE_ALIGNMENT - 1) / OWN_IMAGE_ALIGNMENT * OWN_IMAGE_ALIGNMENT;
+
+    for (uint32_t i = 0; i < args.num_images; i++)
+    {
+        const vx_image image = i < num_src ? src_images[i] : dst_image;
+
+        if (image->width != width || image->height != dst_image->height || !ownCheckStrides(image))
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        const size_t row_size = ownGetRowSize(image->image_type, width);
+        const size_t capacity = image->image_type == VX_DF_IMAGE_U1_EXT ? (row_size + image->padding) * 8 :
+                                                                            (row_size + image->padding) / ownGetPixelSize(image->image_type);
+        if (!ownIsRowDense(image) || capacity < row_count)
+            row_count = ownIsRowDense(image) ? capacity : width;
+
+        args.images[i] = image;
+        args.merge_rows = args.merge_rows && CanMergeRows(image);
+        row_bytes += row_size;
+    }
+
+    args.row_count = (uint32_t)row_count;
+
+    ownParallelFor(dst_image->height, row_bytes, MapRows, &args);
+    return args.out_of_memory ? VX_ERROR_NO_MEMORY : VX_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static size_t RoundUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+typedef struct
+{
+    vx_df_image format;
+    uint32_t width;
+    uint32_t height;
+} PlaneLayout;
+
+// Returns the number of planes of the format or 0 if the image cannot be described
+static uint32_t GetPlaneLayout(vx_df_image color, uint32_t width, uint32_t height, PlaneLayout planes[OWN_MAX_PLANES])
+{
+    uint32_t num_planes;
+
+    if (width == 0 || height == 0)
+        return 0;
+
+    switch (color)
+    {
+    case VX_DF_IMAGE_NV12:
+    case VX_DF_IMAGE_NV21:
+        if (width % 2 || height % 2)
+            return 0;
+        // interleaved chroma pairs are described as 16-bit pixels
+        planes[1].format = VX_DF_IMAGE_U16;
+        planes[1].width = width / 2;
+        planes[1].height = height / 2;
+        num_planes = 2;
+        break;
+    case VX_DF_IMAGE_IYUV:
+        if (width % 2 || height % 2)
+            return 0;
+        planes[1].format = planes[2].format = VX_DF_IMAGE_U8;
+        planes[1].width = planes[2].width = width / 2;
+        planes[1].height = planes[2].height = height / 2;
+        num_planes = 3;
+        break;
+    case VX_DF_IMAGE_YUV4:
+        planes[1].format = planes[2].format = VX_DF_IMAGE_U8;
+        planes[1].width = planes[2].width = width;
+        planes[1].height = planes[2].height = height;
+        num_planes = 3;
+        break;
+    case VX_DF_IMAGE_UYVY:
+    case VX_DF_IMAGE_YUYV:
+        if (width % 2)
+            return 0;
+        planes[0].format = color;
+        planes[0].width = width;
+        planes[0].height = height;
+        return 1;
+    default:
+        if (ownGetRowSize(color, width) == 0)
+            return 0;
+        planes[0].format = color;
+        planes[0].width = width;
+        planes[0].height = height;
+        return 1;
+    }
+
+    planes[0].format = VX_DF_IMAGE_U8;
+    planes[0].width = width;
+    planes[0].height = height;
+    return num_planes;
+}
+
+static void InitImage(vx_image image, void* data, const PlaneLayout* layout)
+{
+    image->data = data;
+    image->width = layout->width;
+    image->height = layout->height;
+    image->image_type = (enum vx_df_image_e)layout->format;
+    image->color_space = VX_COLOR_SPACE_DEFAULT;
+    image->stride_x = 0;
+    image->stride_y = 0;
+    image->memory = NULL;
+    image->border = 0;
+    image->padding = 0;
+    image->num_planes = 1;
+    image->import_type = VX_IMPORT_TYPE_NONE;
+    image->planes = NULL;
+    image->scope = NULL;
+}
+
+typedef struct
+{
+    size_t row_size;
+    size_t left;
+    size_t stride;
+    size_t rows;
+} ImageLayout;
+
+static bool GetImageLayout(const vx_image image, uint32_t border, ImageLayout* layout)
+{
+    const vx_df_image color = image->image_type;
+    const size_t border_bytes = color == VX_DF_IMAGE_U1_EXT ? ((size_t)border + 7) / 8 : (size_t)border * ownGetPixelSize(color);
+
+    layout->row_size = ownGetRowSize(color, image->width);
+    if (layout->row_size == 0 || image->height == 0)
+        return false;
+
+    // every row starts on an aligned address: the left border is rounded up,
+    // the row with its right border is padded to a whole number of vectors
+    layout->left = RoundUp(border_bytes, OWN_IMAGE_ALIGNMENT);
+    layout->stride = layout->left + RoundUp(layout->row_size + border_bytes, OWN_IMAGE_ALIGNMENT);
+    layout->rows = (size_t)image->height + 2 * (size_t)border;
+
+    return layout->stride <= INT32_MAX && layout->rows <= SIZE_MAX / layout->stride;
+}
+
+size_t ownGetImageAllocSize(const vx_image image, uint32_t border)
+{
+    ImageLayout layout;
+    return GetImageLayout(image, border, &layout) ? layout.stride * layout.rows : 0;
+}
+
+void ownBindImage(vx_image image, void* memory, uint32_t border)
+{
+    ImageLayout layout;
+    GetImageLayout(image, border, &layout);
+
+    image->data = (uint8_t*)memory + (size_t)border * layout.stride + layout.left;
+    image->stride_x = 0;
+    image->stride_y = (int32_t)layout.stride;
+    image->border = border;
+    image->padding = (uint32_t)(layout.stride - layout.left - layout.row_size);
+}
+
+void ownInitRowsView(vx_image view, const vx_image image, uint32_t y_begin, uint32_t y_end)
+{
+    *view = *image;
+    view->data = ownGetPixelPtr(image, 0, y_begin);
+    view->height = y_end - y_begin;
+    view->memory = NULL;
+    view->border = 0;
+    view->planes = NULL;
+    view->scope = NULL;
+}
+
+vx_status ownAllocateImage(vx_image image, uint32_t border)
+{
+    const size_t size = ownGetImageAllocSize(image, border);
+    if (size == 0)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    void* memory = ownAlignedAlloc(size, OWN_IMAGE_ALIGNMENT);
+    if (!memory)
+        return VX_ERROR_NO_MEMORY;
+    memset(memory, 0, size);
+
+    ownBindImage(image, memory, border);
+    image->memory = memory;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_image VX_API_CALL vxCreateImage(vx_context context, vx_uint32 width, vx_uint32 height, vx_df_image color)
+{
+    PlaneLayout layout[OWN_MAX_PLANES];
+
+    // multi-plane images are only supported through vxCreateImageFromHandle so far
+    if (!context || GetPlaneLayout(color, width, height, layout) != 1)
+        return NULL;
+
+    vx_image image = (vx_image)malloc(sizeof(struct _vx_image));
+    if (!image)
+        return NULL;
+
+    InitImage(image, NULL, &layout[0]);
+    if (ownAllocateImage(image, context->image_border) != VX_SUCCESS)
+    {
+        free(image);
+        return NULL;
+    }
+    return image;
+}
+
+// The size and format may stay unset; the node writing the image sets them
+// and the memory is allocated when the graph is verified
+VX_API_ENTRY vx_image VX_API_CALL vxCreateVirtualImage(vx_graph graph, vx_uint32 width, vx_uint32 height, vx_df_image color)
+{
+    if (!graph)
+        return NULL;
+
+    // multi-plane virtual images are not supported
+    if (color != VX_DF_IMAGE_VIRT && ownGetRowSize(color, 1) == 0)
+        return NULL;
+
+    vx_image image = (vx_image)malloc(sizeof(struct _vx_image));
+    if (!image)
+        return NULL;
+
+    PlaneLayout layout;
+    layout.format = color;
+    layout.width = width;
+    layout.height = height;
+    InitImage(image, NULL, &layout);
+
+    if (ownAddVirtualImage(graph, image) != VX_SUCCESS)
+    {
+        free(image);
+        return NULL;
+    }
+    return image;
+}
+
+VX_API_ENTRY vx_image VX_API_CALL vxCreateImageFromHandle(vx_context context, vx_df_image color, vx_imagepatch_addressing_t addrs[], void *ptrs[], vx_enum import_type)
+{
+    if (!context || !addrs || !ptrs || import_type != VX_IMPORT_TYPE_HOST)
+        return NULL;
+
+    PlaneLayout layout[OWN_MAX_PLANES];
+    const uint32_t num_planes = GetPlaneLayout(color, addrs[0].dim_x, addrs[0].dim_y, layout);
+    if (num_planes == 0)
+        return NULL;
+
+    // plane sizes follow from the format, the caller only supplies the strides
+    struct _vx_image planes[OWN_MAX_PLANES];
+    for (uint32_t p = 0; p < num_planes; p++)
+    {
+        if (!ptrs[p])
+            return NULL;
+
+        InitImage(&planes[p], ptrs[p], &layout[p]);
+        planes[p].stride_x = layout[p].format == VX_DF_IMAGE_U1_EXT ? 0 : addrs[p].stride_x;
+        planes[p].stride_y = addrs[p].stride_y;
+        planes[p].import_type = VX_IMPORT_TYPE_HOST;
+
+        if (!ownCheckStrides(&planes[p]))
+            return NULL;
+    }
+
+    vx_image image = (vx_image)malloc(sizeof(struct _vx_image));
+    if (!image)
+        return NULL;
+
+    *image = planes[0];
+    image->image_type = (enum vx_df_image_e)color;
+
+    if (num_planes > 1)
+    {
+        image->planes = (vx_image)malloc(num_planes * sizeof(struct _vx_image));
+        if (!image->planes)
+        {
+            free(image);
+            return NULL;
+        }
+        memcpy(image->planes, planes, num_planes * sizeof(struct _vx_image));
+        image->num_planes = num_planes;
+    }
+
+    return image;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSwapImageHandleExt(vx_image image, void* const new_ptrs[], void* prev_ptrs[], vx_size num_planes)
+{
+    if (!image || image->import_type != VX_IMPORT_TYPE_HOST)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    if (!new_ptrs || num_planes != ownGetNumPlanes(image))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    for (uint32_t p = 0; p < num_planes; p++)
+    {
+        if (!new_ptrs[p])
+            return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    for (uint32_t p = 0; p < num_planes; p++)
+    {
+        vx_image plane = ownGetPlane(image, p);
+        if (prev_ptrs)
+            prev_ptrs[p] = plane->data;
+        plane->data = new_ptrs[p];
+    }
+    image->data = new_ptrs[0];
+
+    return VX_SUCCESS;
+}
+
+// The view shares the parent's pixels and does not keep a reference to it, so
+// the parent must outlive the view
+VX_API_ENTRY vx_image VX_API_CALL vxCreateImageFromROI(vx_image img, const vx_rectangle_t *rect)
+{
+    if (!img || !rect || img->scope || ownGetNumPlanes(img) > 1 || !ownCheckStrides(img))
+        return NULL;
+
+    if (rect->start_x >= rect->end_x || rect->end_x > img->width ||
+        rect->start_y >= rect->end_y || rect->end_y > img->height)
+        return NULL;
+
+    const uint32_t width = rect->end_x - rect->start_x;
+
+    // packed rows of the view have to start on a word and must not end inside
+    // a word shared with pixels of the parent, whose padding bits get cleared
+    if (img->image_type == VX_DF_IMAGE_U1_EXT &&
+        (rect->start_x % 64 != 0 || (rect->end_x != img->width && width % 64 != 0)))
+        return NULL;
+
+    vx_image view = (vx_image)malloc(sizeof(struct _vx_image));
+    if (!view)
+        return NULL;
+
+    PlaneLayout layout;
+    layout.format = img->image_type;
+    layout.width = width;
+    layout.height = rect->end_y - rect->start_y;
+
+    InitImage(view, ownGetPixelPtr(img, rect->start_x, rect->start_y), &layout);
+    view->color_space = img->color_space;
+    view->stride_x = img->image_type == VX_DF_IMAGE_U1_EXT ? 0 : ownGetStrideX(img);
+    view->stride_y = ownGetStrideY(img);
+    // a view that ends with the parent's rows also ends with their padding
+    view->padding = rect->end_x == img->width ? img->padding : 0;
+    return view;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryImage(vx_image image, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!image)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_IMAGE_ATTRIBUTE_WIDTH:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = image->width;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_HEIGHT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = image->height;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_FORMAT:
+        if (size != sizeof(vx_df_image))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_df_image*)ptr = (vx_df_image)image->image_type;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_PLANES:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = ownGetNumPlanes(image);
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_SPACE:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = (vx_enum)image->color_space;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_RANGE:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = VX_CHANNEL_RANGE_FULL;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_SIZE:
+    {
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+
+        vx_size total = 0;
+        for (uint32_t p = 0; p < ownGetNumPlanes(image); p++)
+            total += ownGetImageSize(ownGetPlane(image, p));
+        *(vx_size*)ptr = total;
+        return VX_SUCCESS;
+    }
+
+    case VX_IMAGE_ATTRIBUTE_ALIGNMENT_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = ownGetAlignment(image);
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_PADDING_EXT:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = image->padding;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_BORDER_EXT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = image->border;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseImage(vx_image *image)
+{
+    if (!image || !*image)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    // virtual images belong to their graph and are freed with it
+    if ((*image)->scope)
+    {
+        *image = NULL;
+        return VX_SUCCESS;
+    }
+
+    // views and imported images do not own their pixels
+    ownAlignedFree((*image)->memory);
+    free((*image)->planes);
+    free(*image);
+    *image = NULL;
+    return VX_SUCCESS;
+}
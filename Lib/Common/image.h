@@ -0,0 +1,195 @@
+/*
+    File: image.h
+    Содержит вспомогательные функции для работы с изображениями.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __IMAGE_H__
+#define __IMAGE_H__
+
+#include <stddef.h>
+
+#include "types.h"
+#include "vx_ext.h"
+#include "platform.h"
+
+/*
+    Constant: OWN_IMAGE_ALIGNMENT
+    Выравнивание строк изображений, создаваемых <vxCreateImage>, в байтах.
+    Длина строки с дополнением также кратна этому значению, что покрывает
+    ширину векторных регистров всех поддерживаемых наборов инструкций.
+*/
+#define OWN_IMAGE_ALIGNMENT 64
+
+/*
+    Constant: OWN_MAX_PLANES
+    Максимальное количество плоскостей изображения.
+*/
+#define OWN_MAX_PLANES 3
+
+/*
+    Function: ownGetRowSize
+    Возвращает размер плотно упакованной строки изображения в байтах. Строки
+    изображения VX_DF_IMAGE_U1_EXT дополняются до целого числа 64-битных слов.
+
+    Return:
+        Размер строки или 0 для неподдерживаемого формата.
+*/
+size_t ownGetRowSize(vx_df_image format, uint32_t width);
+
+/*
+    Function: ownGetPixelSize
+    Возвращает размер пикселя в байтах или 0 для упакованных форматов и
+    неподдерживаемых форматов.
+*/
+uint32_t ownGetPixelSize(vx_df_image format);
+
+/*
+    Function: ownGetNumPlanes
+    Возвращает количество плоскостей изображения.
+*/
+uint32_t ownGetNumPlanes(const vx_image image);
+
+/*
+    Function: ownGetPlane
+    Возвращает описание плоскости plane как одноплоскостного изображения.
+    Плоскость 1 изображений NV12 и NV21 имеет формат VX_DF_IMAGE_U16: каждый
+    её пиксель - пара байт цветности. Для одноплоскостного изображения
+    возвращает само изображение.
+*/
+vx_image ownGetPlane(const vx_image image, uint32_t plane);
+
+/*
+    Function: ownGetImageSize
+    Возвращает размер данных плотно упакованного изображения в байтах.
+*/
+size_t ownGetImageSize(const vx_image image);
+
+/*
+    Functions: ownGetStrideX, ownGetStrideY
+    Возвращают шаги изображения в байтах с учётом значений по умолчанию.
+*/
+int32_t ownGetStrideX(const vx_image image);
+int32_t ownGetStrideY(const vx_image image);
+
+/*
+    Function: ownGetPixelPtr
+    Возвращает указатель на пиксель (x, y). Для VX_DF_IMAGE_U1_EXT x
+    должен быть кратен 8.
+*/
+VX_INLINE uint8_t* ownGetPixelPtr(const vx_image image, uint32_t x, uint32_t y)
+{
+    const ptrdiff_t offset_x = image->image_type == VX_DF_IMAGE_U1_EXT ? (ptrdiff_t)(x / 8) : (ptrdiff_t)x * ownGetStrideX(image);
+    return (uint8_t*)image->data + (ptrdiff_t)y * ownGetStrideY(image) + offset_x;
+}
+
+/*
+    Function: ownCheckStrides
+    Проверяет, что шаги изображения допустимы: пиксели строки не
+    перекрываются, строки упакованных изображений не разрежены.
+*/
+bool ownCheckStrides(const vx_image image);
+
+/*
+    Function: ownIsRowDense
+    Возвращает true, если пиксели строки идут подряд (stride_x равен
+    размеру пикселя), и строку можно обрабатывать как непрерывный массив.
+*/
+bool ownIsRowDense(const vx_image image);
+
+/*
+    Function: ownLoadRow
+    Возвращает указатель на непрерывную строку y. Если пиксели строки идут
+    не подряд, они копируются в buffer (width * размер пикселя байт).
+*/
+const void* ownLoadRow(const vx_image image, uint32_t y, void* buffer);
+
+/*
+    Functions: ownGetRowOutput, ownStoreRow
+    ownGetRowOutput возвращает указатель, по которому записывается строка y:
+    саму строку изображения или buffer, если пиксели строки идут не подряд.
+    ownStoreRow переносит строку из buffer в изображение (если запись
+    выполнялась в buffer).
+*/
+void* ownGetRowOutput(vx_image image, uint32_t y, void* buffer);
+void ownStoreRow(vx_image image, uint32_t y, const void* row);
+
+/*
+    Function: ownGetAlignment
+    Возвращает наибольшую степень двойки (не более 4096), на которую делятся
+    адреса начала всех строк изображения.
+*/
+size_t ownGetAlignment(const vx_image image);
+
+/*
+    Function: ownAllocateImage
+    Выделяет память для одноплоскостного изображения с заданными шириной,
+    высотой и форматом так же, как <vxCreateImage>: строки выровнены на
+    <OWN_IMAGE_ALIGNMENT> и окружены рамкой border пикселей.
+
+    Return:
+        VX_SUCCESS                  - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - размеры или формат не заданы;
+        VX_ERROR_NO_MEMORY          - не удалось выделить память.
+*/
+vx_status ownAllocateImage(vx_image image, uint32_t border);
+
+/*
+    Functions: ownGetImageAllocSize, ownBindImage
+    ownGetImageAllocSize возвращает размер памяти, которую <ownAllocateImage>
+    выделила бы для изображения (0, если размеры или формат не заданы).
+    ownBindImage размещает изображение в памяти такого размера, выровненной
+    на <OWN_IMAGE_ALIGNMENT>, не передавая изображению владение ею.
+*/
+size_t ownGetImageAllocSize(const vx_image image, uint32_t border);
+void ownBindImage(vx_image image, void* memory, uint32_t border);
+
+/*
+    Function: ownInitRowsView
+    Заполняет view описанием строк [y_begin, y_end) одноплоскостного
+    изображения image без копирования данных. view не владеет памятью и не
+    освобождается <vxReleaseImage>.
+*/
+void ownInitRowsView(vx_image view, const vx_image image, uint32_t y_begin, uint32_t y_end);
+
+/*
+    Type: own_row_f
+    Обработка count пикселей строки: src - непрерывные строки входных
+    изображений, dst - непрерывная строка выходного изображения.
+*/
+typedef void (*own_row_f)(const void* const* src, void* dst, uint32_t count, const void* params);
+
+/*
+    Constant: OWN_MAP_MAX_SRC
+    Максимальное количество входных изображений <ownMapRows>.
+*/
+#define OWN_MAP_MAX_SRC 3
+
+/*
+    Function: ownMapRows
+    Применяет func ко всем строкам изображений на пуле потоков контекста.
+    Шаги изображений учитываются: если все изображения плотно упакованы,
+    несколько строк обрабатываются одним вызовом, иначе строки передаются по
+    одной, а разреженные строки копируются во временные буферы. Дополнение
+    строк выходного изображения VX_DF_IMAGE_U1_EXT обнуляется.
+
+    Если у всех изображений за концом строки есть дополнение (padding), count
+    округляется вверх в пределах дополнения, и func обрабатывает строку
+    целыми векторами без хвоста.
+
+    Parameters:
+        src_images - входные изображения (не более <OWN_MAP_MAX_SRC>);
+        num_src    - количество входных изображений;
+        dst_image  - выходное изображение;
+        func       - функция обработки строки;
+        params     - параметры функции.
+
+    Return:
+        VX_SUCCESS                  - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - размеры изображений не совпадают или
+                                      шаги недопустимы;
+        VX_ERROR_NO_MEMORY          - не удалось выделить временные буферы.
+*/
+vx_status ownMapRows(const vx_image* src_images, uint32_t num_src, vx_image dst_image, own_row_f func, const void* params);
+
+#endif // __IMAGE_H__
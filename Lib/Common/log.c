@@ -0,0 +1,574 @@
+/*
+    File: log.c
+    Содержит реализацию журнала сообщений <vxAddLogEntry>.
+
+    Date: 18 Октября 2026
+*/
+
+#include "log.h"
+#include "context.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// VS2013 has no C99 snprintf; the truncating variant always terminates the output
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define snprintf(buffer, size, ...) _snprintf_s(buffer, size, _TRUNCATE, __VA_ARGS__)
+#endif
+
+// Positions run over twice the ring size, so a full ring differs from an empty one
+#define POSITION_MASK (2 * OWN_LOG_RING_SIZE - 1)
+
+#define MAX_ARGS 8
+
+// Offset of a copied string that was a null pointer
+#define NULL_STRING UINT32_MAX
+
+// Longest conversion specification rebuilt for snprintf
+#define MAX_SPEC_LEN 32
+
+typedef union
+{
+    long long i;
+    unsigned long long u;
+    double d;
+    const void* p;
+} LogValue;
+
+// An entry takes 256 bytes; the text holds the format followed by copies of
+// its string arguments
+#define TEXT_SIZE (256 - MAX_ARGS * sizeof(LogValue) - sizeof(vx_reference) - 2 * sizeof(uint32_t))
+
+typedef struct
+{
+    LogValue args[MAX_ARGS];
+    vx_reference ref;
+    vx_status status;
+    uint32_t num_args;
+    char text[TEXT_SIZE];
+} LogEntry;
+
+struct _own_log_ring
+{
+    LogEntry* entries;
+    struct _own_log_ring* next;
+    // written by the owning thread only
+    volatile int32_t head;
+    // written by the draining thread only
+    volatile int32_t tail;
+    // entries lost to a full ring since the last drain
+    volatile int32_t dropped;
+    // under the log_lock of the context
+    uint32_t in_use;
+};
+
+enum
+{
+    LENGTH_NONE,
+    LENGTH_HH,
+    LENGTH_H,
+    LENGTH_L,
+    LENGTH_LL,
+    LENGTH_J,
+    LENGTH_Z,
+    LENGTH_T,
+    LENGTH_LONG_DOUBLE
+};
+
+enum
+{
+    KIND_LITERAL, // unknown conversion, printed as is
+    KIND_PERCENT,
+    KIND_SIGNED,
+    KIND_UNSIGNED,
+    KIND_CHAR,
+    KIND_DOUBLE,
+    KIND_POINTER,
+    KIND_STRING,
+    KIND_SKIP     // %n and wide strings: the argument is consumed, nothing is printed
+};
+
+typedef struct
+{
+    const char* modifiers; // the length modifier, after flags, width and precision
+    const char* end;       // past the conversion character
+    uint32_t length;
+    uint32_t kind;
+    uint32_t num_stars;
+} Spec;
+
+// The ring of the current thread; the context id tells a stale ring of a
+// destroyed context from a live one
+static OWN_THREAD_LOCAL own_log_ring t_ring = NULL;
+static OWN_THREAD_LOCAL vx_context t_ring_context = NULL;
+static OWN_THREAD_LOCAL uint32_t t_ring_context_id = 0;
+
+// Parses the conversion specification at p, which points at '%'. Returns
+// false if the format ends inside the specification.
+static bool ParseSpec(const char* p, Spec* spec)
+{
+    spec->num_stars = 0;
+
+    p++;
+    while (*p && strchr("-+ #0", *p))
+        p++;
+    if (*p == '*')
+    {
+        spec->num_stars++;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            spec->num_stars++;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+
+    spec->modifiers = p;
+    switch (*p)
+    {
+    case 'h': spec->length = p[1] == 'h' ? LENGTH_HH : LENGTH_H; break;
+    case 'l': spec->length = p[1] == 'l' ? LENGTH_LL : LENGTH_L; break;
+    case 'j': spec->length = LENGTH_J; break;
+    case 'z': spec->length = LENGTH_Z; break;
+    case 't': spec->length = LENGTH_T; break;
+    case 'L': spec->length = LENGTH_LONG_DOUBLE; break;
+    default: spec->length = LENGTH_NONE; break;
+    }
+    if (spec->length == LENGTH_HH || spec->length == LENGTH_LL)
+        p += 2;
+    else if (spec->length != LENGTH_NONE)
+        p++;
+
+    const char conversion = *p;
+    if (!conversion)
+        return false;
+    spec->end = p + 1;
+
+    switch (conversion)
+    {
+    case '%':
+        spec->kind = KIND_PERCENT;
+        break;
+    case 'd': case 'i':
+        spec->kind = KIND_SIGNED;
+        break;
+    case 'u': case 'o': case 'x': case 'X':
+        spec->kind = KIND_UNSIGNED;
+        break;
+    case 'c':
+        spec->kind = spec->length == LENGTH_L ? KIND_SKIP : KIND_CHAR;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        spec->kind = KIND_DOUBLE;
+        break;
+    case 'p':
+        spec->kind = KIND_POINTER;
+        break;
+    case 's':
+        spec->kind = spec->length == LENGTH_L ? KIND_SKIP : KIND_STRING;
+        break;
+    case 'n':
+        spec->kind = KIND_SKIP;
+        break;
+    default:
+        spec->kind = KIND_LITERAL;
+        break;
+    }
+    return true;
+}
+
+static bool TakesArgument(uint32_t kind)
+{
+    return kind != KIND_LITERAL && kind != KIND_PERCENT;
+}
+
+// Copies a string argument after the text already used. Returns its offset.
+static uint32_t CopyString(LogEntry* entry, size_t* used, uint32_t empty, const char* string)
+{
+    if (!string)
+        return NULL_STRING;
+
+    const size_t begin = *used;
+    if (begin >= TEXT_SIZE)
+        return empty;
+
+    size_t n = 0;
+    while (begin + n + 1 < TEXT_SIZE && string[n])
+    {
+        entry->text[begin + n] = string[n];
+        n++;
+    }
+    entry->text[begin + n] = '\0';
+    *used = begin + n + 1;
+    return (uint32_t)begin;
+}
+
+// Integers are widened at capture, so the drain needs one conversion per kind
+static LogValue FetchArgument(const Spec* spec, va_list* args, LogEntry* entry, size_t* used, uint32_t empty)
+{
+    LogValue value;
+    value.u = 0;
+
+    switch (spec->kind)
+    {
+    case KIND_SIGNED:
+        switch (spec->length)
+        {
+        case LENGTH_HH: value.i = (signed char)va_arg(*args, int); break;
+        case LENGTH_H:  value.i = (short)va_arg(*args, int); break;
+        case LENGTH_L:  value.i = va_arg(*args, long); break;
+        case LENGTH_LL:
+        case LENGTH_J:  value.i = va_arg(*args, long long); break;
+        case LENGTH_Z:  value.i = (long long)va_arg(*args, size_t); break;
+        case LENGTH_T:  value.i = va_arg(*args, ptrdiff_t); break;
+        default:        value.i = va_arg(*args, int); break;
+        }
+        break;
+
+    case KIND_UNSIGNED:
+        switch (spec->length)
+        {
+        case LENGTH_HH: value.u = (unsigned char)va_arg(*args, unsigned int); break;
+        case LENGTH_H:  value.u = (unsigned short)va_arg(*args, unsigned int); break;
+        case LENGTH_L:  value.u = va_arg(*args, unsigned long); break;
+        case LENGTH_LL:
+        case LENGTH_J:  value.u = va_arg(*args, unsigned long long); break;
+        case LENGTH_Z:  value.u = va_arg(*args, size_t); break;
+        case LENGTH_T:  value.u = (unsigned long long)va_arg(*args, ptrdiff_t); break;
+        default:        value.u = va_arg(*args, unsigned int); break;
+        }
+        break;
+
+    case KIND_CHAR:
+        value.i = va_arg(*args, int);
+        break;
+
+    case KIND_DOUBLE:
+        value.d = spec->length == LENGTH_LONG_DOUBLE ? (double)va_arg(*args, long double) : va_arg(*args, double);
+        break;
+
+    case KIND_STRING:
+        value.u = CopyString(entry, used, empty, va_arg(*args, const char*));
+        break;
+
+    default: // pointers and skipped arguments
+        value.p = va_arg(*args, void*);
+        break;
+    }
+    return value;
+}
+
+// Copies the format and its arguments; nothing is formatted here. A format
+// longer than the entry, or with more arguments than it holds, is cut short.
+static void CaptureEntry(LogEntry* entry, const char* message, va_list* args)
+{
+    size_t length = 0;
+    while (length + 1 < TEXT_SIZE && message[length])
+    {
+        entry->text[length] = message[length];
+        length++;
+    }
+    entry->text[length] = '\0';
+
+    size_t used = length + 1;
+    const uint32_t empty = (uint32_t)length;
+    uint32_t num_args = 0;
+
+    for (char* p = strchr(entry->text, '%'); p; p = strchr(p, '%'))
+    {
+        Spec spec;
+        if (!ParseSpec(p, &spec))
+            break;
+
+        const uint32_t needed = spec.num_stars + (TakesArgument(spec.kind) ? 1 : 0);
+        if (num_args + needed > MAX_ARGS)
+        {
+            *p = '\0';
+            break;
+        }
+
+        for (uint32_t s = 0; s < spec.num_stars; s++)
+            entry->args[num_args++].i = va_arg(*args, int);
+        if (TakesArgument(spec.kind))
+            entry->args[num_args++] = FetchArgument(&spec, args, entry, &used, empty);
+
+        p = (char*)spec.end;
+    }
+    entry->num_args = num_args;
+}
+
+// Rebuilds the specification for snprintf: stars are replaced by the captured
+// values and integers take the widened length. Returns false if it is too long.
+static bool BuildSpec(const char* p, const Spec* spec, const LogEntry* entry, uint32_t* arg, char* out)
+{
+    size_t n = 0;
+    for (; p < spec->modifiers; p++)
+    {
+        if (n + 16 >= MAX_SPEC_LEN)
+            return false;
+
+        if (*p == '*')
+        {
+            snprintf(out + n, MAX_SPEC_LEN - n, "%d", (int)entry->args[(*arg)++].i);
+            n += strlen(out + n);
+        }
+        else
+        {
+            out[n++] = *p;
+        }
+    }
+
+    if (spec->kind == KIND_SIGNED || spec->kind == KIND_UNSIGNED)
+    {
+        out[n++] = 'l';
+        out[n++] = 'l';
+    }
+    out[n++] = spec->end[-1];
+    out[n] = '\0';
+    return true;
+}
+
+static void FormatEntry(const LogEntry* entry, char* out, size_t size)
+{
+    size_t used = 0;
+    uint32_t arg = 0;
+
+    const char* p = entry->text;
+    while (*p && used + 1 < size)
+    {
+        if (*p != '%')
+        {
+            out[used++] = *p++;
+            continue;
+        }
+
+        Spec spec;
+        char format[MAX_SPEC_LEN];
+        if (!ParseSpec(p, &spec) || !BuildSpec(p, &spec, entry, &arg, format))
+            break;
+
+        LogValue value;
+        value.u = 0;
+        if (TakesArgument(spec.kind))
+            value = entry->args[arg++];
+
+        char* dst = out + used;
+        const size_t room = size - used;
+        dst[0] = '\0';
+
+        switch (spec.kind)
+        {
+        case KIND_LITERAL:
+        {
+            const size_t count = (size_t)(spec.end - p) < room - 1 ? (size_t)(spec.end - p) : room - 1;
+            memcpy(dst, p, count);
+            dst[count] = '\0';
+            break;
+        }
+        case KIND_PERCENT:  dst[0] = '%'; dst[1] = '\0'; break;
+        case KIND_SIGNED:   snprintf(dst, room, format, value.i); break;
+        case KIND_UNSIGNED: snprintf(dst, room, format, value.u); break;
+        case KIND_CHAR:     snprintf(dst, room, format, (int)value.i); break;
+        case KIND_DOUBLE:   snprintf(dst, room, format, value.d); break;
+        case KIND_POINTER:  snprintf(dst, room, format, value.p); break;
+        case KIND_STRING:
+            snprintf(dst, room, format, value.u == NULL_STRING ? "(null)" : entry->text + value.u);
+            break;
+        default:
+            break;
+        }
+
+        used += strlen(dst);
+        p = spec.end;
+    }
+    out[used] = '\0';
+}
+
+static own_log_ring GetRing(vx_context context)
+{
+    if (t_ring && t_ring_context == context && t_ring_context_id == context->id)
+        return t_ring;
+
+    ownSpinLock(&context->log_lock);
+    own_log_ring ring = context->log_rings;
+    while (ring && ring->in_use)
+        ring = ring->next;
+    if (!ring)
+    {
+        ring = (own_log_ring)calloc(1, sizeof(struct _own_log_ring));
+        if (ring)
+            ring->entries = (LogEntry*)malloc(OWN_LOG_RING_SIZE * sizeof(LogEntry));
+        if (ring && ring->entries)
+        {
+            ring->next = context->log_rings;
+            context->log_rings = ring;
+        }
+        else if (ring)
+        {
+            free(ring);
+            ring = NULL;
+        }
+    }
+    if (ring)
+        ring->in_use = 1;
+    ownSpinUnlock(&context->log_lock);
+
+    t_ring = ring;
+    t_ring_context = context;
+    t_ring_context_id = context->id;
+    if (ring)
+        ownWatchThreadExit(context);
+    return ring;
+}
+
+// Called with log_draining held. Rings only ever join the front of the list,
+// so the list is walked from a snapshot of its head.
+static void DrainRings(vx_context context, vx_log_callback_f callback)
+{
+    char message[VX_MAX_LOG_MESSAGE_LEN];
+
+    ownSpinLock(&context->log_lock);
+    own_log_ring rings = context->log_rings;
+    ownSpinUnlock(&context->log_lock);
+
+    for (own_log_ring ring = rings; ring; ring = ring->next)
+    {
+        const int32_t head = ownAtomicLoad(&ring->head);
+        int32_t tail = ring->tail;
+        while (tail != head)
+        {
+            const LogEntry* entry = &ring->entries[tail & (OWN_LOG_RING_SIZE - 1)];
+            if (callback)
+            {
+                FormatEntry(entry, message, sizeof(message));
+                callback(context, entry->ref, entry->status, message);
+            }
+
+            // the slot goes back to the owner only after the callback
+            const int32_t next = (tail + 1) & POSITION_MASK;
+            ownAtomicCompareExchange(&ring->tail, tail, next);
+            tail = next;
+        }
+
+        const int32_t dropped = ownAtomicLoad(&ring->dropped);
+        if (dropped)
+        {
+            ownAtomicAdd(&ring->dropped, -dropped);
+            if (callback)
+            {
+                snprintf(message, sizeof(message), "%d log entries were dropped: the log was not flushed in time", dropped);
+                callback(context, (vx_reference)context, VX_FAILURE, message);
+            }
+        }
+    }
+}
+
+void ownFlushLog(vx_context context)
+{
+    if (!context || !ownAtomicLoad(&context->log_enabled))
+        return;
+
+    if (ownAtomicCompareExchange(&context->log_draining, 0, 1) != 0)
+        return;
+    DrainRings(context, context->log_callback);
+    ownSpinUnlock(&context->log_draining);
+}
+
+void ownReleaseLogRing(vx_context context)
+{
+    // a stale context is only compared, never read
+    if (!t_ring || !context || t_ring_context != context || t_ring_context_id != context->id)
+        return;
+
+    ownSpinLock(&context->log_lock);
+    t_ring->in_use = 0;
+    ownSpinUnlock(&context->log_lock);
+
+    t_ring = NULL;
+    t_ring_context = NULL;
+}
+
+void ownReleaseLog(vx_context context)
+{
+    ownFlushLog(context);
+
+    while (context->log_rings)
+    {
+        own_log_ring next = context->log_rings->next;
+        free(context->log_rings->entries);
+        free(context->log_rings);
+        context->log_rings = next;
+    }
+}
+
+VX_API_ENTRY void VX_API_CALL vxAddLogEntry(vx_reference ref, vx_status status, const char *message, ...)
+{
+    if (!ref || !message || status == VX_SUCCESS)
+        return;
+
+    vx_context context = ownGetContext();
+    if (!context || !ownAtomicLoad(&context->log_enabled))
+        return;
+
+    own_log_ring ring = GetRing(context);
+    if (!ring)
+        return;
+
+    // the caller never waits for the drain: a full ring loses the entry
+    const int32_t head = ring->head;
+    if (((head - ownAtomicLoad(&ring->tail)) & POSITION_MASK) == OWN_LOG_RING_SIZE)
+    {
+        ownAtomicAdd(&ring->dropped, 1);
+        return;
+    }
+
+    LogEntry* entry = &ring->entries[head & (OWN_LOG_RING_SIZE - 1)];
+    entry->ref = ref;
+    entry->status = status;
+
+    va_list args;
+    va_start(args, message);
+    CaptureEntry(entry, message, &args);
+    va_end(args);
+
+    // publishes the entry to the drain
+    ownAtomicCompareExchange(&ring->head, head, (head + 1) & POSITION_MASK);
+}
+
+VX_API_ENTRY void VX_API_CALL vxRegisterLogCallback(vx_context context, vx_log_callback_f callback, vx_bool reentrant)
+{
+    // entries are handed over by one thread at a time, so the callback is
+    // never entered concurrently whatever the flag says
+    (void)reentrant;
+
+    if (!context)
+        return;
+
+    ownSpinLock(&context->log_draining);
+
+    // entries added before the change go to the previous callback
+    DrainRings(context, context->log_callback);
+
+    context->log_callback = callback;
+    ownAtomicCompareExchange(&context->log_enabled, context->log_enabled, callback ? 1 : 0);
+    ownSpinUnlock(&context->log_draining);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxFlushLogExt(vx_context context)
+{
+    if (!context)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    ownFlushLog(context);
+    return VX_SUCCESS;
+}
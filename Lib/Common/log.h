@@ -0,0 +1,51 @@
+/*
+    File: log.h
+    Содержит журнал сообщений <vxAddLogEntry>.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __LOG_H__
+#define __LOG_H__
+
+#include "types.h"
+
+/*
+    Constant: OWN_LOG_RING_SIZE
+    Количество записей в кольцевом буфере потока. Записи, которые не
+    поместились до очередной выдачи журнала, отбрасываются.
+*/
+#define OWN_LOG_RING_SIZE 64
+
+/*
+    Type: own_log_ring
+    Кольцевой буфер записей журнала одного потока. Записи добавляет только
+    поток-владелец, забирает только выдающий журнал поток, поэтому буфер
+    обходится без блокировок.
+*/
+typedef struct _own_log_ring* own_log_ring;
+
+/*
+    Function: ownFlushLog
+    Выдаёт накопленные записи журнала обработчику <vxRegisterLogCallback>
+    на вызывающем потоке. Сообщения форматируются здесь, а не при
+    добавлении записи. Если журнал уже выдаёт другой поток, функция сразу
+    возвращает управление: его записи выдаст тот поток.
+*/
+void ownFlushLog(vx_context context);
+
+/*
+    Function: ownReleaseLogRing
+    Открепляет кольцевой буфер от вызывающего потока, чтобы его мог взять
+    другой поток, если поток получил его от контекста context. Невыданные
+    записи остаются в буфере. Вызывается рабочими потоками пула перед
+    завершением, остальными потоками - при завершении.
+*/
+void ownReleaseLogRing(vx_context context);
+
+/*
+    Function: ownReleaseLog
+    Выдаёт оставшиеся записи и освобождает буферы журнала контекста.
+*/
+void ownReleaseLog(vx_context context);
+
+#endif // __LOG_H__
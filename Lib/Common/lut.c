@@ -0,0 +1,217 @@
+/*
+    File: lut.c
+    Содержит построение и применение таблиц преобразования 8 бит -> 8 бит.
+
+    Date: 18 Октября 2026
+*/
+
+#include "lut.h"
+#include "cpu.h"
+#include "image.h"
+
+#include <math.h>
+
+void ownLutIdentity(uint8_t table[OWN_LUT8_SIZE])
+{
+    for (uint32_t i = 0; i < OWN_LUT8_SIZE; i++)
+        table[i] = (uint8_t)i;
+}
+
+void ownLutAppend(uint8_t table[OWN_LUT8_SIZE], const uint8_t op[OWN_LUT8_SIZE])
+{
+    for (uint32_t i = 0; i < OWN_LUT8_SIZE; i++)
+        table[i] = op[table[i]];
+}
+
+vx_status ownLutFromThreshold(uint8_t table[OWN_LUT8_SIZE], const vx_threshold thresh)
+{
+    int32_t lower;
+    int32_t upper;
+
+    if (thresh->data_type != VX_TYPE_INVALID && thresh->data_type != VX_TYPE_UINT8)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (thresh->threshold_type)
+    {
+    case VX_THRESHOLD_TYPE_BINARY:
+        lower = thresh->value < UINT8_MAX ? thresh->value + 1 : UINT8_MAX + 1;
+        upper = UINT8_MAX;
+        break;
+    case VX_THRESHOLD_TYPE_RANGE:
+        lower = thresh->lower_threshold;
+        upper = thresh->upper_threshold;
+        break;
+    default:
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    const uint8_t true_value = thresh->data_type == VX_TYPE_INVALID ? UINT8_MAX : thresh->true_value;
+    const uint8_t false_value = thresh->data_type == VX_TYPE_INVALID ? 0 : thresh->false_value;
+
+    for (int32_t i = 0; i < OWN_LUT8_SIZE; i++)
+        table[i] = (i >= lower && i <= upper) ? true_value : false_value;
+
+    return VX_SUCCESS;
+}
+
+static uint8_t SaturateRound(float value)
+{
+    if (!(value > 0.0f)) // also catches NaN
+        return 0;
+    if (value >= UINT8_MAX)
+        return UINT8_MAX;
+    return (uint8_t)(value + 0.5f);
+}
+
+void ownLutFromContrast(uint8_t table[OWN_LUT8_SIZE], float gain, float bias)
+{
+    for (uint32_t i = 0; i < OWN_LUT8_SIZE; i++)
+        table[i] = SaturateRound(gain * (float)i + bias);
+}
+
+void ownLutFromGamma(uint8_t table[OWN_LUT8_SIZE], float gamma)
+{
+    for (uint32_t i = 0; i < OWN_LUT8_SIZE; i++)
+        table[i] = SaturateRound(UINT8_MAX * powf((float)i / UINT8_MAX, gamma));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef void (*ApplyLutFunc)(const uint8_t* src, uint8_t* dst, uint32_t count, const uint8_t* table);
+
+static void ApplyLutScalar(const uint8_t* src, uint8_t* dst, uint32_t count, const uint8_t* table)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint8_t a = table[src[i + 0]];
+        const uint8_t b = table[src[i + 1]];
+        const uint8_t c = table[src[i + 2]];
+        const uint8_t d = table[src[i + 3]];
+        dst[i + 0] = a;
+        dst[i + 1] = b;
+        dst[i + 2] = c;
+        dst[i + 3] = d;
+    }
+    for (; i < count; i++)
+        dst[i] = table[src[i]];
+}
+
+#ifdef VX_ARCH_X86
+
+/*
+    The table is split into 16 sub-tables of 16 entries, sub-table k covering
+    values [16k, 16k + 15]. For sub-table k the index is v - 16k saturated
+    into bit 7 (adds_epu8 with 0x70): values of other sub-tables get the
+    high bit set and pshufb returns 0 for them, so OR-ing the 16 lookups
+    gives the result.
+*/
+
+VX_TARGET_SSSE3
+static __m128i LookupSSSE3(__m128i v, const __m128i sub[16])
+{
+    const __m128i step = _mm_set1_epi8(16);
+    const __m128i bias = _mm_set1_epi8(0x70);
+
+    __m128i result = _mm_setzero_si128();
+    for (uint32_t k = 0; k < 16; k++)
+    {
+        result = _mm_or_si128(result, _mm_shuffle_epi8(sub[k], _mm_adds_epu8(v, bias)));
+        v = _mm_sub_epi8(v, step);
+    }
+    return result;
+}
+
+VX_TARGET_SSSE3
+static void ApplyLutSSSE3(const uint8_t* src, uint8_t* dst, uint32_t count, const uint8_t* table)
+{
+    __m128i sub[16];
+    for (uint32_t k = 0; k < 16; k++)
+        sub[k] = _mm_loadu_si128((const __m128i*)(table + 16 * k));
+
+    uint32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), LookupSSSE3(v, sub));
+    }
+
+    ApplyLutScalar(src + i, dst + i, count - i, table);
+}
+
+VX_TARGET_AVX2
+static __m256i LookupAVX2(__m256i v, const __m256i sub[16])
+{
+    const __m256i step = _mm256_set1_epi8(16);
+    const __m256i bias = _mm256_set1_epi8(0x70);
+
+    __m256i result = _mm256_setzero_si256();
+    for (uint32_t k = 0; k < 16; k++)
+    {
+        result = _mm256_or_si256(result, _mm256_shuffle_epi8(sub[k], _mm256_adds_epu8(v, bias)));
+        v = _mm256_sub_epi8(v, step);
+    }
+    return result;
+}
+
+VX_TARGET_AVX2
+static void ApplyLutAVX2(const uint8_t* src, uint8_t* dst, uint32_t count, const uint8_t* table)
+{
+    // vpshufb looks up within 128-bit lanes, so each sub-table is duplicated
+    __m256i sub[16];
+    for (uint32_t k = 0; k < 16; k++)
+        sub[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(table + 16 * k)));
+
+    uint32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), LookupAVX2(v, sub));
+    }
+
+    ApplyLutScalar(src + i, dst + i, count - i, table);
+}
+
+#endif
+
+static ApplyLutFunc SelectApplyLut(void)
+{
+#ifdef VX_ARCH_X86
+    const uint32_t features = ownGetCpuFeatures();
+    if (features & VX_CPU_FEATURE_AVX2)
+        return ApplyLutAVX2;
+    if (features & VX_CPU_FEATURE_SSSE3)
+        return ApplyLutSSSE3;
+#endif
+    return ApplyLutScalar;
+}
+
+void ownApplyLut8(const uint8_t* src, uint8_t* dst, uint32_t count, const uint8_t table[OWN_LUT8_SIZE])
+{
+    SelectApplyLut()(src, dst, count, table);
+}
+
+// The row function is selected on the calling thread, whose instruction set
+// mask (see ownSetCpuFeatureMask) the workers do not share
+typedef struct
+{
+    ApplyLutFunc apply;
+    const uint8_t* table;
+} ApplyLutArgs;
+
+static void ApplyLutRow(const void* const* src, void* dst, uint32_t count, const void* params)
+{
+    const ApplyLutArgs* args = (const ApplyLutArgs*)params;
+    args->apply((const uint8_t*)src[0], (uint8_t*)dst, count, args->table);
+}
+
+vx_status ownApplyLutImage(const vx_image src_image, vx_image dst_image, const uint8_t table[OWN_LUT8_SIZE])
+{
+    if (src_image->image_type != VX_DF_IMAGE_U8 || dst_image->image_type != VX_DF_IMAGE_U8)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    ApplyLutArgs args;
+    args.apply = SelectApplyLut();
+    args.table = table;
+    return ownMapRows(&src_image, 1, dst_image, ApplyLutRow, &args);
+}
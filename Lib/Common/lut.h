@@ -0,0 +1,79 @@
+/*
+    File: lut.h
+    Содержит построение и применение таблиц преобразования 8 бит -> 8 бит.
+    Цепочка поэлементных операций (порог, таблица, контраст, гамма)
+    сворачивается в одну таблицу, которая применяется за один проход.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __LUT_H__
+#define __LUT_H__
+
+#include <stdint.h>
+
+#include "types.h"
+
+/*
+    Constant: OWN_LUT8_SIZE
+    Количество элементов таблицы для 8-битных изображений.
+*/
+#define OWN_LUT8_SIZE 256
+
+/*
+    Function: ownLutIdentity
+    Заполняет таблицу тождественным преобразованием.
+*/
+void ownLutIdentity(uint8_t table[OWN_LUT8_SIZE]);
+
+/*
+    Function: ownLutAppend
+    Добавляет операцию op после уже накопленных в table:
+    table[i] = op[table[i]].
+*/
+void ownLutAppend(uint8_t table[OWN_LUT8_SIZE], const uint8_t op[OWN_LUT8_SIZE]);
+
+/*
+    Function: ownLutFromThreshold
+    Строит таблицу пороговой обработки 8-битного изображения (значения
+    true/false порога или 255/0, см. <_vx_threshold>).
+
+    Return:
+        VX_SUCCESS                  - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - неизвестный тип порога.
+*/
+vx_status ownLutFromThreshold(uint8_t table[OWN_LUT8_SIZE], const vx_threshold thresh);
+
+/*
+    Function: ownLutFromContrast
+    Строит таблицу линейного преобразования яркости
+    dst = saturate(round(gain * src + bias)).
+*/
+void ownLutFromContrast(uint8_t table[OWN_LUT8_SIZE], float gain, float bias);
+
+/*
+    Function: ownLutFromGamma
+    Строит таблицу гамма-коррекции dst = round(255 * (src / 255) ^ gamma).
+*/
+void ownLutFromGamma(uint8_t table[OWN_LUT8_SIZE], float gamma);
+
+/*
+    Function: ownApplyLut8
+    Применяет таблицу к count подряд идущим пикселям. Реализация (pshufb по
+    16 подтаблицам для SSSE3/AVX2 или скалярная) выбирается по возможностям
+    процессора.
+*/
+void ownApplyLut8(const uint8_t* src, uint8_t* dst, uint32_t count, const uint8_t table[OWN_LUT8_SIZE]);
+
+/*
+    Function: ownApplyLutImage
+    Применяет таблицу к 8-битному изображению, распределяя строки по потокам
+    контекста.
+
+    Return:
+        VX_SUCCESS                  - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - размеры или форматы изображений не совпадают
+                                      либо отличаются от VX_DF_IMAGE_U8.
+*/
+vx_status ownApplyLutImage(const vx_image src_image, vx_image dst_image, const uint8_t table[OWN_LUT8_SIZE]);
+
+#endif // __LUT_H__
@@ -0,0 +1,293 @@
+/*
+    File: parallel.c
+    Содержит пул потоков и параллельный цикл по строкам изображения.
+
+    Date: 18 Октября 2026
+*/
+
+#include "parallel.h"
+#include "context.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Rows are handed out in chunks of about this many bytes (fits L2 together with the output)
+#define PARALLEL_CHUNK_BYTES (64 * 1024)
+
+// Images smaller than this are processed on the calling thread
+#define PARALLEL_MIN_BYTES (256 * 1024)
+
+#define POOL_INITIAL_CAPACITY 64
+
+typedef struct
+{
+    own_task_f func;
+    void* arg;
+    const void* owner;
+} Task;
+
+struct _own_thread_pool
+{
+    own_mutex_t lock;
+    own_cond_t wake;    // signalled when a task is queued or the pool stops
+    own_cond_t done;    // broadcast when a parallel-for helper finishes
+
+    Task* tasks;        // ring buffer
+    uint32_t head;
+    uint32_t count;
+    uint32_t capacity;
+
+    own_thread_t* threads;
+    uint32_t num_workers;
+    uint32_t stop;
+};
+
+static void WorkerLoop(void* arg)
+{
+    own_thread_pool pool = (own_thread_pool)arg;
+
+    ownLockMutex(&pool->lock);
+    for (;;)
+    {
+        while (!pool->stop && pool->count == 0)
+            ownWaitCond(&pool->wake, &pool->lock);
+
+        if (pool->count == 0)
+            break; // stopped and drained
+
+        const Task task = pool->tasks[pool->head];
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+
+        ownUnlockMutex(&pool->lock);
+        task.func(task.arg);
+        ownLockMutex(&pool->lock);
+    }
+    ownUnlockMutex(&pool->lock);
+
+    // the pool is only released while its context is alive
+    const vx_context context = ownGetContext();
+    ownReleaseScratchArena(context);
+    ownReleaseLogRing(context);
+    ownWatchThreadExit(NULL);
+}
+
+own_thread_pool ownCreateThreadPool(uint32_t num_workers)
+{
+    own_thread_pool pool = (own_thread_pool)calloc(1, sizeof(struct _own_thread_pool));
+    if (!pool)
+        return NULL;
+
+    pool->tasks = (Task*)malloc(POOL_INITIAL_CAPACITY * sizeof(Task));
+    pool->threads = (own_thread_t*)calloc(num_workers ? num_workers : 1, sizeof(own_thread_t));
+    if (!pool->tasks || !pool->threads)
+    {
+        free(pool->tasks);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    pool->capacity = POOL_INITIAL_CAPACITY;
+
+    ownInitMutex(&pool->lock);
+    ownInitCond(&pool->wake);
+    ownInitCond(&pool->done);
+
+    for (uint32_t i = 0; i < num_workers; i++)
+    {
+        if (!ownCreateThread(&pool->threads[pool->num_workers], WorkerLoop, pool))
+            break;
+        pool->num_workers++;
+    }
+
+    return pool;
+}
+
+void ownReleaseThreadPool(own_thread_pool* pool)
+{
+    if (!pool || !*pool)
+        return;
+
+    own_thread_pool p = *pool;
+
+    ownLockMutex(&p->lock);
+    p->stop = 1;
+    ownBroadcastCond(&p->wake);
+    ownUnlockMutex(&p->lock);
+
+    for (uint32_t i = 0; i < p->num_workers; i++)
+        ownJoinThread(p->threads[i]);
+
+    ownDestroyCond(&p->done);
+    ownDestroyCond(&p->wake);
+    ownDestroyMutex(&p->lock);
+    free(p->threads);
+    free(p->tasks);
+    free(p);
+
+    *pool = NULL;
+}
+
+uint32_t ownGetPoolWorkers(own_thread_pool pool)
+{
+    return pool ? pool->num_workers : 0;
+}
+
+static bool GrowQueue(own_thread_pool pool)
+{
+    const uint32_t capacity = pool->capacity * 2;
+    Task* tasks = (Task*)malloc(capacity * sizeof(Task));
+    if (!tasks)
+        return false;
+
+    for (uint32_t i = 0; i < pool->count; i++)
+        tasks[i] = pool->tasks[(pool->head + i) % pool->capacity];
+
+    free(pool->tasks);
+    pool->tasks = tasks;
+    pool->head = 0;
+    pool->capacity = capacity;
+    return true;
+}
+
+bool ownSubmitTask(own_thread_pool pool, own_task_f task, void* arg, const void* owner)
+{
+    ownLockMutex(&pool->lock);
+
+    if (pool->count == pool->capacity && !GrowQueue(pool))
+    {
+        ownUnlockMutex(&pool->lock);
+        return false;
+    }
+
+    Task* slot = &pool->tasks[(pool->head + pool->count) % pool->capacity];
+    slot->func = task;
+    slot->arg = arg;
+    slot->owner = owner;
+    pool->count++;
+
+    ownSignalCond(&pool->wake);
+    ownUnlockMutex(&pool->lock);
+    return true;
+}
+
+static uint32_t CancelTasksLocked(own_thread_pool pool, const void* owner)
+{
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < pool->count; i++)
+    {
+        const Task task = pool->tasks[(pool->head + i) % pool->capacity];
+        if (task.owner != owner)
+            pool->tasks[(pool->head + kept++) % pool->capacity] = task;
+    }
+
+    const uint32_t removed = pool->count - kept;
+    pool->count = kept;
+    return removed;
+}
+
+uint32_t ownCancelTasks(own_thread_pool pool, const void* owner)
+{
+    ownLockMutex(&pool->lock);
+    const uint32_t removed = CancelTasksLocked(pool, owner);
+    ownUnlockMutex(&pool->lock);
+    return removed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    own_rows_f func;
+    void* data;
+    uint32_t height;
+    uint32_t rows_per_chunk;
+    int32_t num_chunks;
+    volatile int32_t next_chunk;
+    uint32_t active_helpers; // guarded by pool->lock
+    own_thread_pool pool;
+} ParallelJob;
+
+static void RunChunks(ParallelJob* job)
+{
+    for (;;)
+    {
+        const int32_t chunk = ownAtomicAdd(&job->next_chunk, 1) - 1;
+        if (chunk >= job->num_chunks)
+            break;
+
+        const uint32_t y_begin = (uint32_t)chunk * job->rows_per_chunk;
+        const uint32_t y_end = job->height - y_begin > job->rows_per_chunk ? y_begin + job->rows_per_chunk : job->height;
+        job->func(job->data, y_begin, y_end);
+    }
+}
+
+static void HelperTask(void* arg)
+{
+    ParallelJob* job = (ParallelJob*)arg;
+    own_thread_pool pool = job->pool;
+
+    RunChunks(job);
+
+    // the job lives on the caller's stack: do not touch it after unlocking
+    ownLockMutex(&pool->lock);
+    job->active_helpers--;
+    ownBroadcastCond(&pool->done);
+    ownUnlockMutex(&pool->lock);
+}
+
+void ownParallelFor(uint32_t height, size_t row_bytes, own_rows_f func, void* data)
+{
+    if (height == 0)
+        return;
+
+    const size_t total_bytes = (size_t)height * row_bytes;
+    vx_context context = ownGetContext();
+    own_thread_pool pool = total_bytes < PARALLEL_MIN_BYTES ? NULL : ownAcquireThreadPool(context);
+
+    if (!pool)
+    {
+        func(data, 0, height);
+        return;
+    }
+
+    ParallelJob job;
+    job.func = func;
+    job.data = data;
+    job.height = height;
+    job.rows_per_chunk = row_bytes < PARALLEL_CHUNK_BYTES ? (uint32_t)(PARALLEL_CHUNK_BYTES / (row_bytes ? row_bytes : 1)) : 1;
+    job.num_chunks = (int32_t)((height + job.rows_per_chunk - 1) / job.rows_per_chunk);
+    job.next_chunk = 0;
+    job.active_helpers = 0;
+    job.pool = pool;
+
+    uint32_t helpers = (uint32_t)job.num_chunks - 1;
+    if (helpers > pool->num_workers)
+        helpers = pool->num_workers;
+
+    ownLockMutex(&pool->lock);
+    job.active_helpers = helpers;
+    ownUnlockMutex(&pool->lock);
+
+    for (uint32_t i = 0; i < helpers; i++)
+    {
+        if (!ownSubmitTask(pool, HelperTask, &job, &job))
+        {
+            ownLockMutex(&pool->lock);
+            job.active_helpers -= helpers - i;
+            ownUnlockMutex(&pool->lock);
+            break;
+        }
+    }
+
+    // the caller works too, so the loop completes even if every worker is busy
+    RunChunks(&job);
+
+    ownLockMutex(&pool->lock);
+    job.active_helpers -= CancelTasksLocked(pool, &job);
+    while (job.active_helpers > 0)
+        ownWaitCond(&pool->done, &pool->lock);
+    ownUnlockMutex(&pool->lock);
+
+    ownDropThreadPool(context, pool);
+}
@@ -0,0 +1,94 @@
+/*
+    File: parallel.h
+    Содержит пул потоков и параллельный цикл по строкам изображения.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __PARALLEL_H__
+#define __PARALLEL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+    Type: own_thread_pool
+    Пул постоянных рабочих потоков с общей очередью задач.
+*/
+typedef struct _own_thread_pool* own_thread_pool;
+
+/*
+    Type: own_task_f
+    Задача, исполняемая рабочим потоком.
+*/
+typedef void (*own_task_f)(void* arg);
+
+/*
+    Type: own_rows_f
+    Обработка строк [y_begin, y_end) изображения.
+*/
+typedef void (*own_rows_f)(void* data, uint32_t y_begin, uint32_t y_end);
+
+/*
+    Function: ownCreateThreadPool
+    Создаёт пул из num_workers рабочих потоков.
+
+    Return:
+        Пул потоков или NULL в случае ошибки.
+*/
+own_thread_pool ownCreateThreadPool(uint32_t num_workers);
+
+/*
+    Function: ownReleaseThreadPool
+    Дожидается выполнения поставленных задач, останавливает потоки и
+    освобождает пул.
+*/
+void ownReleaseThreadPool(own_thread_pool* pool);
+
+/*
+    Function: ownGetPoolWorkers
+    Возвращает количество рабочих потоков пула.
+*/
+uint32_t ownGetPoolWorkers(own_thread_pool pool);
+
+/*
+    Function: ownSubmitTask
+    Ставит задачу в очередь пула.
+
+    Parameters:
+        pool  - пул потоков;
+        task  - функция задачи;
+        arg   - аргумент функции;
+        owner - владелец задачи, используется в <ownCancelTasks>.
+
+    Return:
+        true  - задача поставлена в очередь;
+        false - не хватило памяти.
+*/
+bool ownSubmitTask(own_thread_pool pool, own_task_f task, void* arg, const void* owner);
+
+/*
+    Function: ownCancelTasks
+    Удаляет из очереди ещё не начатые задачи владельца owner.
+
+    Return:
+        Количество удалённых задач.
+*/
+uint32_t ownCancelTasks(own_thread_pool pool, const void* owner);
+
+/*
+    Function: ownParallelFor
+    Делит строки [0, height) на порции размером порядка кэша и исполняет их на
+    пуле потоков контекста. Вызывающий поток тоже обрабатывает порции, поэтому
+    функцию можно вызывать из задач пула. Маленькие изображения
+    обрабатываются на вызывающем потоке без обращения к пулу.
+
+    Parameters:
+        height    - количество строк;
+        row_bytes - объём данных, читаемых и записываемых при обработке строки;
+        func      - функция обработки строк;
+        data      - аргумент функции.
+*/
+void ownParallelFor(uint32_t height, size_t row_bytes, own_rows_f func, void* data);
+
+#endif // __PARALLEL_H__
@@ -0,0 +1,213 @@
+/*
+    File: platform.c
+    Содержит переносимые обёртки над средствами операционной системы.
+
+    Date: 18 Октября 2026
+*/
+
+// posix_memalign and clock_gettime are hidden by strict -std=c99/c11 modes
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "platform.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+    own_thread_f func;
+    void* arg;
+} ThreadStart;
+
+#ifdef _WIN32
+
+static DWORD WINAPI ThreadEntry(LPVOID param)
+{
+    ThreadStart start = *(ThreadStart*)param;
+    free(param);
+    start.func(start.arg);
+    return 0;
+}
+
+bool ownCreateThread(own_thread_t* thread, own_thread_f func, void* arg)
+{
+    ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+    if (!start)
+        return false;
+    start->func = func;
+    start->arg = arg;
+
+    *thread = CreateThread(NULL, 0, ThreadEntry, start, 0, NULL);
+    if (*thread == NULL)
+    {
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void ownJoinThread(own_thread_t thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+void ownInitMutex(own_mutex_t* mutex)    { InitializeCriticalSection(mutex); }
+void ownDestroyMutex(own_mutex_t* mutex) { DeleteCriticalSection(mutex); }
+void ownLockMutex(own_mutex_t* mutex)    { EnterCriticalSection(mutex); }
+void ownUnlockMutex(own_mutex_t* mutex)  { LeaveCriticalSection(mutex); }
+
+void ownInitCond(own_cond_t* cond)                      { InitializeConditionVariable(cond); }
+void ownDestroyCond(own_cond_t* cond)                   { (void)cond; }
+void ownWaitCond(own_cond_t* cond, own_mutex_t* mutex)  { SleepConditionVariableCS(cond, mutex, INFINITE); }
+void ownSignalCond(own_cond_t* cond)                    { WakeConditionVariable(cond); }
+void ownBroadcastCond(own_cond_t* cond)                 { WakeAllConditionVariable(cond); }
+
+// Fiber-local storage is the one Win32 store that calls back on thread exit
+bool ownCreateTlsKey(own_tls_key* key, own_tls_destructor_f destructor)
+{
+    *key = FlsAlloc(destructor);
+    return *key != FLS_OUT_OF_INDEXES;
+}
+
+void ownSetTlsValue(own_tls_key key, void* value)
+{
+    FlsSetValue(key, value);
+}
+
+uint32_t ownGetNumCpus(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (uint32_t)info.dwNumberOfProcessors : 1;
+}
+
+uint64_t ownGetTimeNs(void)
+{
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    // whole seconds and the remainder are scaled apart to avoid overflow
+    const uint64_t ticks = (uint64_t)counter.QuadPart;
+    const uint64_t rate = (uint64_t)frequency.QuadPart;
+    return ticks / rate * 1000000000u + ticks % rate * 1000000000u / rate;
+}
+
+static void YieldThread(void)
+{
+    SwitchToThread();
+}
+
+void* ownAlignedAlloc(size_t size, size_t alignment)
+{
+    return _aligned_malloc(size ? size : 1, alignment);
+}
+
+void ownAlignedFree(void* ptr)
+{
+    _aligned_free(ptr);
+}
+
+#else
+
+static void* ThreadEntry(void* param)
+{
+    ThreadStart start = *(ThreadStart*)param;
+    free(param);
+    start.func(start.arg);
+    return NULL;
+}
+
+bool ownCreateThread(own_thread_t* thread, own_thread_f func, void* arg)
+{
+    ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+    if (!start)
+        return false;
+    start->func = func;
+    start->arg = arg;
+
+    if (pthread_create(thread, NULL, ThreadEntry, start) != 0)
+    {
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void ownJoinThread(own_thread_t thread)
+{
+    pthread_join(thread, NULL);
+}
+
+void ownInitMutex(own_mutex_t* mutex)    { pthread_mutex_init(mutex, NULL); }
+void ownDestroyMutex(own_mutex_t* mutex) { pthread_mutex_destroy(mutex); }
+void ownLockMutex(own_mutex_t* mutex)    { pthread_mutex_lock(mutex); }
+void ownUnlockMutex(own_mutex_t* mutex)  { pthread_mutex_unlock(mutex); }
+
+void ownInitCond(own_cond_t* cond)                      { pthread_cond_init(cond, NULL); }
+void ownDestroyCond(own_cond_t* cond)                   { pthread_cond_destroy(cond); }
+void ownWaitCond(own_cond_t* cond, own_mutex_t* mutex)  { pthread_cond_wait(cond, mutex); }
+void ownSignalCond(own_cond_t* cond)                    { pthread_cond_signal(cond); }
+void ownBroadcastCond(own_cond_t* cond)                 { pthread_cond_broadcast(cond); }
+
+bool ownCreateTlsKey(own_tls_key* key, own_tls_destructor_f destructor)
+{
+    return pthread_key_create(key, destructor) == 0;
+}
+
+void ownSetTlsValue(own_tls_key key, void* value)
+{
+    pthread_setspecific(key, value);
+}
+
+uint32_t ownGetNumCpus(void)
+{
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+uint64_t ownGetTimeNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static void YieldThread(void)
+{
+    sched_yield();
+}
+
+void* ownAlignedAlloc(size_t size, size_t alignment)
+{
+    void* ptr = NULL;
+    return posix_memalign(&ptr, alignment, size ? size : 1) == 0 ? ptr : NULL;
+}
+
+void ownAlignedFree(void* ptr)
+{
+    free(ptr);
+}
+
+#endif
+
+void ownSpinLock(volatile int32_t* lock)
+{
+    while (ownAtomicCompareExchange(lock, 0, 1) != 0)
+        YieldThread();
+}
+
+void ownSpinUnlock(volatile int32_t* lock)
+{
+    ownAtomicCompareExchange(lock, 1, 0);
+}
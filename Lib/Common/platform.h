@@ -0,0 +1,184 @@
+/*
+    File: platform.h
+    Содержит переносимые обёртки над средствами операционной системы:
+    потоки, мьютексы, условные переменные, атомарные операции и часы.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __PLATFORM_H__
+#define __PLATFORM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+#pragma warning(push, 3)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#pragma warning(pop)
+#else
+#include <pthread.h>
+#endif
+
+/*
+    Macro: VX_INLINE
+    Встраиваемая функция (MSVC не поддерживает ключевое слово inline в C).
+*/
+#if defined(_MSC_VER)
+#define VX_INLINE static __inline
+#else
+#define VX_INLINE static inline
+#endif
+
+/*
+    Macro: OWN_THREAD_LOCAL
+    Переменная, у каждого потока своя.
+*/
+#if defined(_MSC_VER)
+#define OWN_THREAD_LOCAL __declspec(thread)
+#else
+#define OWN_THREAD_LOCAL __thread
+#endif
+
+#ifdef _WIN32
+typedef HANDLE             own_thread_t;
+typedef CRITICAL_SECTION   own_mutex_t;
+typedef CONDITION_VARIABLE own_cond_t;
+typedef DWORD              own_tls_key;
+#define OWN_TLS_CALLBACK   WINAPI
+#else
+typedef pthread_t          own_thread_t;
+typedef pthread_mutex_t    own_mutex_t;
+typedef pthread_cond_t     own_cond_t;
+typedef pthread_key_t      own_tls_key;
+#define OWN_TLS_CALLBACK
+#endif
+
+/*
+    Type: own_thread_f
+    Функция, исполняемая в отдельном потоке.
+*/
+typedef void (*own_thread_f)(void* arg);
+
+/*
+    Function: ownCreateThread
+    Создаёт поток, исполняющий функцию func с аргументом arg.
+
+    Return:
+        true  - поток создан;
+        false - не удалось создать поток.
+*/
+bool ownCreateThread(own_thread_t* thread, own_thread_f func, void* arg);
+
+/*
+    Function: ownJoinThread
+    Ожидает завершения потока и освобождает его ресурсы.
+*/
+void ownJoinThread(own_thread_t thread);
+
+void ownInitMutex(own_mutex_t* mutex);
+void ownDestroyMutex(own_mutex_t* mutex);
+void ownLockMutex(own_mutex_t* mutex);
+void ownUnlockMutex(own_mutex_t* mutex);
+
+void ownInitCond(own_cond_t* cond);
+void ownDestroyCond(own_cond_t* cond);
+void ownWaitCond(own_cond_t* cond, own_mutex_t* mutex);
+void ownSignalCond(own_cond_t* cond);
+void ownBroadcastCond(own_cond_t* cond);
+
+/*
+    Type: own_tls_destructor_f
+    Функция, которую завершающийся поток вызывает для непустого значения
+    ключа <ownCreateTlsKey>.
+*/
+typedef void (OWN_TLS_CALLBACK *own_tls_destructor_f)(void* value);
+
+/*
+    Function: ownCreateTlsKey
+    Создаёт ключ значения, у каждого потока своего. Если при завершении
+    потока его значение не NULL, поток вызывает destructor. Ключ не
+    удаляется до завершения процесса.
+
+    Return:
+        true  - ключ создан;
+        false - ключи исчерпаны.
+*/
+bool ownCreateTlsKey(own_tls_key* key, own_tls_destructor_f destructor);
+
+/*
+    Function: ownSetTlsValue
+    Задаёт значение ключа для вызывающего потока.
+*/
+void ownSetTlsValue(own_tls_key key, void* value);
+
+/*
+    Function: ownGetNumCpus
+    Возвращает количество логических процессоров в системе.
+*/
+uint32_t ownGetNumCpus(void);
+
+/*
+    Function: ownGetTimeNs
+    Возвращает время монотонных часов высокого разрешения в наносекундах.
+    Часы не переводятся, поэтому разность показаний - длительность
+    интервала.
+*/
+uint64_t ownGetTimeNs(void);
+
+/*
+    Functions: ownAlignedAlloc, ownAlignedFree
+    Выделяют и освобождают память, выровненную на alignment байт
+    (степень двойки, кратная sizeof(void*)).
+*/
+void* ownAlignedAlloc(size_t size, size_t alignment);
+void ownAlignedFree(void* ptr);
+
+/*
+    Function: ownAtomicAdd
+    Атомарно прибавляет value к *ptr. Возвращает новое значение.
+*/
+VX_INLINE int32_t ownAtomicAdd(volatile int32_t* ptr, int32_t value)
+{
+#ifdef _WIN32
+    return (int32_t)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value) + value;
+#else
+    return __sync_add_and_fetch(ptr, value);
+#endif
+}
+
+/*
+    Function: ownAtomicCompareExchange
+    Атомарно записывает desired в *ptr, если *ptr равно expected.
+    Возвращает предыдущее значение *ptr.
+*/
+VX_INLINE int32_t ownAtomicCompareExchange(volatile int32_t* ptr, int32_t expected, int32_t desired)
+{
+#ifdef _WIN32
+    return (int32_t)InterlockedCompareExchange((volatile LONG*)ptr, (LONG)desired, (LONG)expected);
+#else
+    return __sync_val_compare_and_swap(ptr, expected, desired);
+#endif
+}
+
+/*
+    Function: ownAtomicLoad
+    Читает *ptr с барьером памяти.
+*/
+VX_INLINE int32_t ownAtomicLoad(volatile int32_t* ptr)
+{
+    return ownAtomicAdd(ptr, 0);
+}
+
+/*
+    Functions: ownSpinLock, ownSpinUnlock
+    Простейшая блокировка для редко используемых участков кода (например,
+    ленивой инициализации глобальных объектов), не требующая инициализации.
+*/
+void ownSpinLock(volatile int32_t* lock);
+void ownSpinUnlock(volatile int32_t* lock);
+
+#endif // __PLATFORM_H__
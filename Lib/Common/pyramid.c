@@ -0,0 +1,164 @@
+/*
+    File: pyramid.c
+    Содержит реализацию функций пирамиды изображений OpenVX.
+
+    Date: 18 Октября 2026
+*/
+
+#include "types.h"
+#include "image.h"
+#include "context.h"
+#include "platform.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Level i is ceil(scale * size of level i - 1), at least one pixel
+static uint32_t ScaleSize(uint32_t size, float scale)
+{
+    const uint32_t scaled = (uint32_t)ceil((double)size * scale);
+    return scaled > 0 ? scaled : 1;
+}
+
+VX_API_ENTRY vx_pyramid VX_API_CALL vxCreatePyramid(vx_context context, vx_size levels, vx_float32 scale, vx_uint32 width, vx_uint32 height, vx_df_image format)
+{
+    if (!context || levels == 0 || (scale != VX_SCALE_PYRAMID_HALF && scale != VX_SCALE_PYRAMID_ORB))
+        return NULL;
+
+    // only single-plane formats, as in vxCreateImage
+    if (width == 0 || height == 0 || ownGetRowSize(format, width) == 0)
+        return NULL;
+
+    vx_pyramid pyramid = (vx_pyramid)calloc(1, sizeof(struct _vx_pyramid));
+    if (!pyramid)
+        return NULL;
+
+    pyramid->levels = (struct _vx_image*)calloc(levels, sizeof(struct _vx_image));
+    if (!pyramid->levels)
+    {
+        free(pyramid);
+        return NULL;
+    }
+
+    pyramid->numLevels = levels;
+    pyramid->scale = scale;
+    pyramid->width = width;
+    pyramid->height = height;
+    pyramid->image_type = (enum vx_df_image_e)format;
+
+    // every level size is a whole number of aligned rows, so the levels
+    // placed one after another all start on an aligned address
+    const uint32_t border = context->image_border;
+    size_t total = 0;
+
+    for (vx_size i = 0; i < levels; i++)
+    {
+        vx_image level = &pyramid->levels[i];
+        level->width = i == 0 ? width : ScaleSize(pyramid->levels[i - 1].width, scale);
+        level->height = i == 0 ? height : ScaleSize(pyramid->levels[i - 1].height, scale);
+        level->image_type = (enum vx_df_image_e)format;
+        level->color_space = VX_COLOR_SPACE_DEFAULT;
+        level->num_planes = 1;
+        level->import_type = VX_IMPORT_TYPE_NONE;
+
+        const size_t size = ownGetImageAllocSize(level, border);
+        if (size == 0 || total > SIZE_MAX - size)
+        {
+            free(pyramid->levels);
+            free(pyramid);
+            return NULL;
+        }
+        total += size;
+    }
+
+    pyramid->memory = ownAlignedAlloc(total, OWN_IMAGE_ALIGNMENT);
+    if (!pyramid->memory)
+    {
+        free(pyramid->levels);
+        free(pyramid);
+        return NULL;
+    }
+    memset(pyramid->memory, 0, total);
+
+    uint8_t* memory = (uint8_t*)pyramid->memory;
+    for (vx_size i = 0; i < levels; i++)
+    {
+        ownBindImage(&pyramid->levels[i], memory, border);
+        memory += ownGetImageAllocSize(&pyramid->levels[i], border);
+    }
+
+    return pyramid;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxReleasePyramid(vx_pyramid *pyr)
+{
+    if (!pyr || !*pyr)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    ownAlignedFree((*pyr)->memory);
+    free((*pyr)->levels);
+    free(*pyr);
+    *pyr = NULL;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryPyramid(vx_pyramid pyr, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!pyr)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_PYRAMID_ATTRIBUTE_LEVELS:
+        if (size != sizeof(vx_size))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_size*)ptr = pyr->numLevels;
+        return VX_SUCCESS;
+
+    case VX_PYRAMID_ATTRIBUTE_SCALE:
+        if (size != sizeof(vx_float32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_float32*)ptr = pyr->scale;
+        return VX_SUCCESS;
+
+    case VX_PYRAMID_ATTRIBUTE_WIDTH:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = pyr->width;
+        return VX_SUCCESS;
+
+    case VX_PYRAMID_ATTRIBUTE_HEIGHT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = pyr->height;
+        return VX_SUCCESS;
+
+    case VX_PYRAMID_ATTRIBUTE_FORMAT:
+        if (size != sizeof(vx_df_image))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_df_image*)ptr = (vx_df_image)pyr->image_type;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+// The level shares the pyramid's pixels and does not keep a reference to it,
+// so the pyramid must outlive the level, as with vxCreateImageFromROI
+VX_API_ENTRY vx_image VX_API_CALL vxGetPyramidLevel(vx_pyramid pyr, vx_uint32 index)
+{
+    if (!pyr || index >= pyr->numLevels)
+        return NULL;
+
+    vx_image level = (vx_image)malloc(sizeof(struct _vx_image));
+    if (!level)
+        return NULL;
+
+    *level = pyr->levels[index];
+    level->memory = NULL;
+    return level;
+}
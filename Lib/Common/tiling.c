@@ -0,0 +1,390 @@
+/*
+    File: tiling.c
+    Содержит исполнение цепочек узлов графа по полосам строк.
+
+    Date: 18 Октября 2026
+*/
+
+#include "graph.h"
+#include "image.h"
+#include "arena.h"
+#include "context.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Returns the image the node writes or NULL
+static vx_image GetOutputImage(const vx_node node)
+{
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->kernel->directions[p] == VX_OUTPUT && node->kernel->types[p] == VX_TYPE_IMAGE)
+            return (vx_image)node->params[p];
+    }
+    return NULL;
+}
+
+static bool ReadsImage(const vx_node node, const vx_image image)
+{
+    for (uint32_t p = 0; p < node->kernel->num_params; p++)
+    {
+        if (node->kernel->directions[p] == VX_INPUT && node->params[p] == (vx_reference)image)
+            return true;
+    }
+    return false;
+}
+
+// A node runs on bands when its kernel reads a bounded neighbourhood, it
+// writes a single image and every image it uses is one plane of the size
+// shared by the group
+static bool IsTileable(const vx_node node, uint32_t width, uint32_t height)
+{
+    const vx_kernel kernel = node->kernel;
+    // the halo describes the library implementation, an added one gets whole images
+    if (!kernel->halo || node->impl.function)
+        return false;
+
+    uint32_t outputs = 0;
+    for (uint32_t p = 0; p < kernel->num_params; p++)
+    {
+        if (!node->params[p])
+            continue;
+
+        if (kernel->types[p] != VX_TYPE_IMAGE)
+        {
+            if (kernel->directions[p] == VX_OUTPUT)
+                return false;
+            continue;
+        }
+
+        const vx_image image = (vx_image)node->params[p];
+        if (image->width != width || image->height != height || ownGetNumPlanes(image) > 1)
+            return false;
+        if (kernel->directions[p] == VX_OUTPUT)
+            outputs++;
+    }
+    return outputs == 1;
+}
+
+bool ownIsTileInternal(const vx_graph graph, const vx_image image)
+{
+    if (!image->scope)
+        return false;
+
+    const own_tile_group* group = NULL;
+    for (uint32_t n = 0; n < graph->num_order; n++)
+    {
+        const vx_node node = graph->order[n];
+        for (uint32_t p = 0; p < node->kernel->num_params; p++)
+        {
+            if (node->params[p] != (vx_reference)image)
+                continue;
+            if (!node->group || (group && node->group != group))
+                return false;
+            group = node->group;
+        }
+    }
+    return group != NULL;
+}
+
+void ownReleaseTileGroups(vx_graph graph)
+{
+    for (uint32_t i = 0; i < graph->num_groups; i++)
+    {
+        own_tile_group* group = graph->groups[i];
+        for (uint32_t k = 0; k < group->num_members; k++)
+            group->members[k]->group = NULL;
+        free(group->members);
+        free(group->flags);
+        free(group);
+    }
+    free(graph->groups);
+    graph->groups = NULL;
+    graph->num_groups = 0;
+}
+
+// Makes the nodes at positions [first, last] of the execution order a group
+static vx_status CreateGroup(vx_graph graph, uint32_t first, uint32_t last)
+{
+    const uint32_t count = last - first + 1;
+
+    own_tile_group* group = (own_tile_group*)calloc(1, sizeof(own_tile_group));
+    own_tile_group** groups = (own_tile_group**)realloc(graph->groups, ((size_t)graph->num_groups + 1) * sizeof(own_tile_group*));
+    if (groups)
+        graph->groups = groups;
+    if (group)
+    {
+        group->members = (vx_node*)malloc(count * sizeof(vx_node));
+        group->flags = (uint32_t*)calloc(count, sizeof(uint32_t));
+    }
+    if (!group || !groups || !group->members || !group->flags)
+    {
+        if (group)
+        {
+            free(group->members);
+            free(group->flags);
+        }
+        free(group);
+        return VX_ERROR_NO_MEMORY;
+    }
+
+    for (uint32_t k = 0; k < count; k++)
+    {
+        vx_node node = graph->order[first + k];
+        node->group = group;
+        node->halo = node->kernel->halo(node);
+        group->members[k] = node;
+    }
+    group->num_members = count;
+    group->first = first;
+    group->last = last;
+    group->height = GetOutputImage(group->members[0])->height;
+
+    graph->groups[graph->num_groups++] = group;
+    return VX_SUCCESS;
+}
+
+/*
+    A node has to produce its band widened by the rows the later nodes of
+    the group read around theirs, so the widening grows from the end of the
+    group to its start. The band height follows from the tile size and the
+    bytes a band row touches in every image, but is kept at least eight times
+    the widest reach: each band recomputes the reach rows on both sides.
+*/
+static void PlanGroup(const vx_graph graph, own_tile_group* group)
+{
+    uint32_t reach = 0;
+    size_t row_bytes = 0;
+
+    for (uint32_t k = group->num_members; k-- > 0;)
+    {
+        vx_node member = group->members[k];
+        const vx_image output = GetOutputImage(member);
+
+        member->extent = 0;
+        for (uint32_t j = k + 1; j < group->num_members; j++)
+        {
+            const vx_node reader = group->members[j];
+            if (ReadsImage(reader, output) && reader->extent + reader->halo > member->extent)
+                member->extent = reader->extent + reader->halo;
+        }
+
+        uint32_t flags = ownIsTileInternal(graph, output) ? 0 : OWN_TILE_EXTERNAL;
+        if (!(flags & OWN_TILE_EXTERNAL) || member->extent + member->halo > 0)
+            flags |= OWN_TILE_BUFFERED;
+        group->flags[k] = flags;
+
+        if (member->extent + member->halo > reach)
+            reach = member->extent + member->halo;
+        row_bytes += ownGetRowSize(output->image_type, output->width);
+
+        for (uint32_t p = 0; p < member->kernel->num_params; p++)
+        {
+            const vx_image input = (vx_image)member->params[p];
+            if (member->kernel->directions[p] == VX_INPUT && member->kernel->types[p] == VX_TYPE_IMAGE &&
+                !ownIsTileInternal(graph, input))
+                row_bytes += ownGetRowSize(input->image_type, input->width);
+        }
+    }
+
+    size_t rows = graph->tile_size / row_bytes;
+    if (rows < 8 * (size_t)reach)
+        rows = 8 * (size_t)reach;
+    if (rows == 0)
+        rows = 1;
+    if (rows > group->height)
+        rows = group->height;
+
+    group->band_rows = (uint32_t)rows;
+    group->band_bytes = rows * row_bytes;
+}
+
+vx_status ownFormTileGroups(vx_graph graph)
+{
+    ownReleaseTileGroups(graph);
+    if (graph->tile_size == 0)
+        return VX_SUCCESS;
+
+    // groups are runs of the execution order: no node outside a run depends
+    // on one of its nodes and feeds another, so a run can execute as one node
+    vx_status status = VX_SUCCESS;
+    uint32_t first = 0;
+    while (first < graph->num_order && status == VX_SUCCESS)
+    {
+        const vx_image output = GetOutputImage(graph->order[first]);
+        if (!output || !IsTileable(graph->order[first], output->width, output->height))
+        {
+            first++;
+            continue;
+        }
+
+        uint32_t end = first + 1;
+        while (end < graph->num_order && IsTileable(graph->order[end], output->width, output->height))
+            end++;
+
+        // a single node gains nothing from bands
+        if (end - first > 1)
+            status = CreateGroup(graph, first, end - 1);
+        first = end;
+    }
+
+    if (status != VX_SUCCESS)
+    {
+        ownReleaseTileGroups(graph);
+        return status;
+    }
+
+    for (uint32_t i = 0; i < graph->num_groups; i++)
+        PlanGroup(graph, graph->groups[i]);
+    return VX_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    own_tile_group* group;
+    volatile int32_t status;
+} TileArgs;
+
+// Rows [begin, end) of the image a member writes, as the later members see them
+typedef struct
+{
+    struct _vx_image image;
+    uint32_t begin;
+    uint32_t end;
+} BandOutput;
+
+static void CopyRows(const vx_image band, uint32_t band_begin, vx_image image, uint32_t y_begin, uint32_t y_end)
+{
+    const size_t row_size = ownGetRowSize(image->image_type, image->width);
+    for (uint32_t y = y_begin; y < y_end; y++)
+    {
+        const uint8_t* row = ownGetPixelPtr(band, 0, y - band_begin);
+        if (ownIsRowDense(image))
+            memcpy(ownGetPixelPtr(image, 0, y), row, row_size);
+        else
+            ownStoreRow(image, y, row);
+    }
+}
+
+/*
+    Runs every member over rows [y_begin, y_end). A member sees its images
+    as views of the rows it needs, so its kernel treats the band as a whole
+    image. The rows within its reach of a view edge that is not an image edge
+    come out wrong, and they are exactly the rows the later members do not
+    read. A band buffer may therefore hold wrong rows at both ends; only the
+    rows of the band itself are copied into an image placed in full.
+*/
+static vx_status RunBand(const own_tile_group* group, uint32_t y_begin, uint32_t y_end, own_arena arena)
+{
+    BandOutput* outputs = (BandOutput*)ownArenaAlloc(arena, group->num_members * sizeof(BandOutput));
+    if (!outputs)
+        return VX_ERROR_NO_MEMORY;
+
+    for (uint32_t k = 0; k < group->num_members; k++)
+    {
+        const vx_node member = group->members[k];
+        const uint32_t reach = member->extent + member->halo;
+        const uint32_t begin = y_begin > reach ? y_begin - reach : 0;
+        const uint32_t end = group->height - y_end > reach ? y_end + reach : group->height;
+
+        // the copy takes only what kernels read: the counters of the member
+        // may change meanwhile (see RecordUnit)
+        struct _vx_node node;
+        memset(&node, 0, sizeof(node));
+        node.graph = member->graph;
+        node.kernel = member->kernel;
+        node.impl = member->impl;
+        node.fused = member->fused;
+        memcpy(node.params, member->params, sizeof(node.params));
+        memcpy(node.values, member->values, sizeof(node.values));
+
+        struct _vx_image inputs[OWN_MAX_KERNEL_PARAMS];
+        BandOutput* output = &outputs[k];
+        vx_image image = NULL;
+
+        for (uint32_t p = 0; p < member->kernel->num_params; p++)
+        {
+            if (member->kernel->types[p] != VX_TYPE_IMAGE)
+                continue;
+
+            if (member->kernel->directions[p] == VX_OUTPUT)
+            {
+                image = (vx_image)member->params[p];
+                output->begin = begin;
+                output->end = end;
+                if (group->flags[k] & OWN_TILE_BUFFERED)
+                {
+                    output->image = *image;
+                    output->image.height = end - begin;
+                    output->image.memory = NULL;
+                    output->image.scope = NULL;
+                    void* memory = ownArenaAlloc(arena, ownGetImageAllocSize(&output->image, 0));
+                    if (!memory)
+                        return VX_ERROR_NO_MEMORY;
+                    ownBindImage(&output->image, memory, 0);
+                }
+                else
+                {
+                    ownInitRowsView(&output->image, image, begin, end);
+                }
+                node.params[p] = (vx_reference)&output->image;
+                continue;
+            }
+
+            // an image written earlier in the group is read from the writer's band
+            uint32_t writer = 0;
+            while (writer < k && GetOutputImage(group->members[writer]) != (vx_image)member->params[p])
+                writer++;
+
+            if (writer < k)
+                ownInitRowsView(&inputs[p], &outputs[writer].image, begin - outputs[writer].begin, end - outputs[writer].begin);
+            else
+                ownInitRowsView(&inputs[p], (vx_image)member->params[p], begin, end);
+            node.params[p] = (vx_reference)&inputs[p];
+        }
+
+        const vx_status status = ownProcessNode(&node);
+        if (status != VX_SUCCESS)
+            return status;
+
+        if ((group->flags[k] & OWN_TILE_BUFFERED) && (group->flags[k] & OWN_TILE_EXTERNAL))
+            CopyRows(&output->image, begin, image, y_begin, y_end);
+    }
+    return VX_SUCCESS;
+}
+
+static void TileBands(void* data, uint32_t band_begin, uint32_t band_end)
+{
+    TileArgs* args = (TileArgs*)data;
+    const own_tile_group* group = args->group;
+    own_arena arena = ownGetScratchArena();
+
+    for (uint32_t band = band_begin; band < band_end; band++)
+    {
+        if (ownAtomicLoad(&args->status) != VX_SUCCESS)
+            return;
+
+        const uint32_t y_begin = band * group->band_rows;
+        const uint32_t y_end = group->height - y_begin > group->band_rows ? y_begin + group->band_rows : group->height;
+
+        const size_t arena_mark = ownArenaMark(arena);
+        const vx_status status = RunBand(group, y_begin, y_end, arena);
+        ownArenaReset(arena, arena_mark);
+
+        if (status != VX_SUCCESS)
+            ownAtomicCompareExchange(&args->status, VX_SUCCESS, status);
+    }
+}
+
+vx_status ownRunTileGroup(own_tile_group* group)
+{
+    TileArgs args;
+    args.group = group;
+    args.status = VX_SUCCESS;
+
+    const uint32_t num_bands = (group->height + group->band_rows - 1) / group->band_rows;
+    ownParallelFor(num_bands, group->band_bytes, TileBands, &args);
+    return args.status;
+}
@@ -14,11 +14,18 @@
 
 #include "openvx/vx.h"
 
-#pragma warning(disable: 4820) // suppress 1 byte padding for vx_threshold
+#pragma warning(disable: 4820) // suppress 2 byte padding for vx_threshold
 
 /*
     Structure: _vx_threshold
     Cтруктура для хранения значения порога.
+
+    Пороги хранятся в int32_t и сравниваются с пикселями входного изображения
+    (VX_DF_IMAGE_U8, VX_DF_IMAGE_U16 или VX_DF_IMAGE_S16). Если data_type
+    равен VX_TYPE_INVALID (значение по умолчанию при обнулении структуры),
+    тип порога определяется входным изображением, а на выходе используются
+    значения 255 и 0. Иначе data_type должен соответствовать формату входного
+    изображения, а на выходе используются true_value и false_value.
 */
 
 struct _vx_threshold
@@ -28,13 +35,22 @@ struct _vx_threshold
     enum vx_threshold_type_e threshold_type;
     //Variable: value
     //значение порога (для Binary);
-    uint8_t value;
+    int32_t value;
     //Variable: address
     //значение верхнего порога;
-    uint8_t upper_threshold;
+    int32_t upper_threshold;
     //Variable: lower_threshold
-    //значение нижнего порога.
-    uint8_t lower_threshold;
+    //значение нижнего порога;
+    int32_t lower_threshold;
+    //Variable: data_type
+    //тип значений порога (VX_TYPE_UINT8, VX_TYPE_UINT16, VX_TYPE_INT16) или VX_TYPE_INVALID;
+    enum vx_type_e data_type;
+    //Variable: true_value
+    //значение выходного пикселя, прошедшего порог;
+    uint8_t true_value;
+    //Variable: false_value
+    //значение выходного пикселя, не прошедшего порог.
+    uint8_t false_value;
 };
 
 #pragma warning(default: 4820)
@@ -42,6 +58,19 @@ struct _vx_threshold
 /*
     Structure: _vx_image
     Cтруктура для хранения изображения.
+
+    Шаги stride_x и stride_y позволяют описывать изображения с выравниванием
+    строк и области других изображений без копирования. Нулевые значения
+    (при инициализации без этих полей) означают плотно упакованное изображение.
+
+    Поля data, stride_x и stride_y многоплоскостного изображения (NV12, IYUV
+    и т.п.) описывают плоскость 0, а массив planes содержит описания всех
+    плоскостей как отдельных одноплоскостных изображений.
+
+    Изображения, созданные <vxCreateImage>, владеют памятью (memory): строки
+    выровнены на <OWN_IMAGE_ALIGNMENT> байт и дополнены, поэтому векторные
+    функции могут обрабатывать строку целыми регистрами без отдельной
+    обработки хвоста.
 */
 struct _vx_image
 {
@@ -58,8 +87,35 @@ struct _vx_image
     //тип изображения;
     enum vx_df_image_e image_type;
     //Variable: color_space
-    //цветовое пространство.
+    //цветовое пространство;
     enum vx_color_space_e color_space;
+    //Variable: stride_x
+    //расстояние между соседними пикселями строки в байтах (0 - размер пикселя);
+    int32_t stride_x;
+    //Variable: stride_y
+    //расстояние между началами соседних строк в байтах (0 - строки идут без промежутков);
+    int32_t stride_y;
+    //Variable: memory
+    //память, выделенная библиотекой для изображения (NULL - память принадлежит приложению);
+    void* memory;
+    //Variable: border
+    //ширина рамки вокруг изображения в пикселях;
+    uint32_t border;
+    //Variable: padding
+    //количество байт за концом строки, которые можно читать и перезаписывать;
+    uint32_t padding;
+    //Variable: num_planes
+    //количество плоскостей (0 и 1 - одна плоскость);
+    uint32_t num_planes;
+    //Variable: import_type
+    //VX_IMPORT_TYPE_HOST, если данные переданы <vxCreateImageFromHandle>;
+    vx_enum import_type;
+    //Variable: planes
+    //описания плоскостей многоплоскостного изображения (NULL для одной плоскости);
+    struct _vx_image* planes;
+    //Variable: scope
+    //граф виртуального изображения (NULL для обычного изображения).
+    vx_graph scope;
 };
 
 /*
@@ -99,18 +155,42 @@ struct _vx_scalar
 /*
     Structure: _vx_array
     Cтруктура для хранения массива.
+
+    Память выделяется по мере добавления элементов и растёт вдвое, так что
+    добавление по одному элементу в среднем не копирует массив. Количество
+    выделенных элементов кратно 16, поэтому векторные циклы могут
+    обрабатывать поля до allocated без отдельной обработки хвоста.
+
+    При раскладке VX_ARRAY_LAYOUT_SOA_EXT элементы из 4-байтовых полей
+    (например, vx_keypoint_t) хранятся по полям: поле f всех элементов
+    лежит непрерывно с адреса data + f * allocated * 4.
 */
 struct _vx_array
 {
     //Variable: data
-    //указатель на содержимое массива;
+    //указатель на содержимое массива (выровнен на 64 байта);
     void* data;
-    //Variable: size
-    //размер массива;
-    uint32_t size;
+    //Variable: num_items
+    //количество элементов;
+    vx_size num_items;
+    //Variable: capacity
+    //максимальное количество элементов (0 - не ограничено);
+    vx_size capacity;
+    //Variable: allocated
+    //количество элементов, под которые выделена память;
+    vx_size allocated;
+    //Variable: item_size
+    //размер элемента в байтах;
+    vx_size item_size;
     //Variable: array_type
-    //тип элементов массива.
-    enum vx_type_e array_type;
+    //тип элементов массива;
+    vx_enum array_type;
+    //Variable: layout
+    //раскладка элементов <vx_array_layout_ext_e>;
+    vx_enum layout;
+    //Variable: accesses
+    //открытые <vxAccessArrayRange> обращения к массиву.
+    struct _own_array_access* accesses;
 };
 
 /*
@@ -197,13 +277,24 @@ typedef struct _vx_keypoint
     float strength;
 } vx_keypoint;
 
+/*
+    Structure: _vx_pyramid
+    Cтруктура для хранения пирамиды изображений.
+
+    Все уровни лежат в одном выровненном блоке памяти, строки каждого уровня
+    дополнены до целого числа векторов. <vxGetPyramidLevel> возвращает
+    изображения, которые ссылаются на этот блок.
+*/
 struct _vx_pyramid {
     //Variable: numLevels
     //Количество уровней в пирамиде;
     size_t numLevels;
     //Variable: levels
-    //указатель на изображения пирамиды;
-    vx_image *levels;
+    //описания изображений уровней (массив из numLevels элементов);
+    struct _vx_image *levels;
+    //Variable: memory
+    //блок памяти всех уровней;
+    void *memory;
     //Variable: scale
     //масштабный коэффициент;
     float scale;
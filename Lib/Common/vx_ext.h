@@ -0,0 +1,517 @@
+/*
+    File: vx_ext.h
+    Содержит расширения OpenVX, реализованные в библиотеке: дополнительные
+    атрибуты объектов и функции, отсутствующие в стандарте.
+
+    Date: 18 Октября 2026
+*/
+#ifndef __VX_EXT_H__
+#define __VX_EXT_H__
+
+#include "openvx/vx.h"
+
+/*
+    Constant: VX_ID_EXT
+    Идентификатор производителя для расширений библиотеки. <VX_ID_DEFAULT>
+    не используется, так как при сдвиге не помещается в vx_enum.
+*/
+#define VX_ID_EXT (0x7FF)
+
+/*
+    Constant: VX_DF_IMAGE_U1_EXT
+    Бинарное изображение, 1 бит на пиксель. Пиксель x строки хранится в бите
+    x % 8 байта x / 8, строка дополняется нулями до целого числа 64-битных
+    слов. Ненулевой бит соответствует значению 255 изображения VX_DF_IMAGE_U8.
+*/
+#define VX_DF_IMAGE_U1_EXT VX_DF_IMAGE('U', '0', '0', '1')
+
+/*
+    Enum: vx_enum_ext_e
+    Идентификаторы перечислений, добавленных в библиотеке.
+*/
+enum vx_enum_ext_e
+{
+    VX_ENUM_POINT_OP_EXT       = 0x00, /* тип поэлементной операции */
+    VX_ENUM_AUTO_THRESHOLD_EXT = 0x01, /* метод выбора порога */
+    VX_ENUM_ARRAY_LAYOUT_EXT   = 0x02, /* раскладка элементов массива */
+    VX_ENUM_TARGET_EXT         = 0x03, /* реализация ядра */
+};
+
+/*
+    Enum: vx_kernel_ext_e
+    Идентификаторы ядер, добавленных в библиотеке.
+*/
+enum vx_kernel_ext_e
+{
+    /*
+        Адаптивная пороговая обработка, см. <vxAdaptiveThresholdNodeExt>.
+    */
+    VX_KERNEL_ADAPTIVE_THRESHOLD_EXT = VX_KERNEL_BASE(VX_ID_EXT, 0) + 0x0,
+    /*
+        Пороговая обработка с автоматическим выбором порога, см. <vxAutoThresholdNodeExt>.
+    */
+    VX_KERNEL_AUTO_THRESHOLD_EXT = VX_KERNEL_BASE(VX_ID_EXT, 0) + 0x1,
+};
+
+/*
+    Enum: vx_context_attribute_ext_e
+    Дополнительные атрибуты контекста.
+*/
+enum vx_context_attribute_ext_e
+{
+    /*
+        Количество потоков, на которых исполняются функции (включая вызывающий).
+        Используйте vx_uint32. Значение 0 означает количество логических процессоров.
+        Пока исполняется граф или параллельная функция, vxSetContextAttribute
+        возвращает VX_FAILURE.
+    */
+    VX_CONTEXT_ATTRIBUTE_NUM_THREADS_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_CONTEXT) + 0x0,
+    /*
+        Ширина рамки в пикселях, которая добавляется вокруг изображений,
+        создаваемых <vxCreateImage> после установки атрибута, чтобы функции
+        могли обращаться к соседям крайних пикселей без проверок. Содержимое
+        рамки не определено. Используйте vx_uint32. По умолчанию 0.
+    */
+    VX_CONTEXT_ATTRIBUTE_IMAGE_BORDER_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_CONTEXT) + 0x1,
+    /*
+        Начальный размер арены временной памяти, которую получает каждый поток
+        для промежуточных данных функций. Действует на арены, создаваемые после
+        установки атрибута. Используйте vx_size.
+    */
+    VX_CONTEXT_ATTRIBUTE_SCRATCH_SIZE_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_CONTEXT) + 0x2,
+    /*
+        Максимальный объём временной памяти, занятый одним потоком за время
+        жизни контекста (только чтение). Значение подходит для
+        VX_CONTEXT_ATTRIBUTE_SCRATCH_SIZE_EXT, чтобы в установившемся режиме
+        арены не росли. Используйте vx_size.
+    */
+    VX_CONTEXT_ATTRIBUTE_SCRATCH_HIGH_WATER_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_CONTEXT) + 0x3,
+    /*
+        Реализация <vx_target_ext_e>, которую узлы получают при проверке
+        графа, если она есть у ядра и поддерживается процессором; иначе узел
+        получает реализацию, выбранную автоматически. Позволяет сравнивать
+        реализации на одном графе: после изменения атрибута граф нужно
+        проверить заново. По умолчанию VX_TARGET_ANY_EXT. Используйте vx_enum.
+    */
+    VX_CONTEXT_ATTRIBUTE_TARGET_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_CONTEXT) + 0x4,
+};
+
+/*
+    Enum: vx_target_ext_e
+    Реализации ядра. У ядра может быть несколько реализаций с приоритетами;
+    при проверке графа узел получает реализацию с наибольшим приоритетом
+    среди тех, чьи наборы инструкций поддерживает процессор (см.
+    VX_CONTEXT_ATTRIBUTE_TARGET_EXT и <vxAddKernelTargetExt>). Реализация
+    исполняется на пуле потоков контекста независимо от набора инструкций;
+    число потоков задаёт VX_CONTEXT_ATTRIBUTE_NUM_THREADS_EXT.
+
+    Реализации VX_TARGET_SSE_EXT и VX_TARGET_AVX2_EXT есть у ядер
+    Threshold, TableLookup и AutoThreshold, а также у слитых поэлементных
+    узлов; остальные ядра библиотеки имеют только VX_TARGET_REF_EXT.
+*/
+enum vx_target_ext_e
+{
+    /*
+        Любая реализация: выбирается автоматически. Функции <vxAddKernel>
+        имеют эту реализацию.
+    */
+    VX_TARGET_ANY_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_TARGET_EXT) + 0x0,
+    /*
+        Эталонная реализация на C без SIMD-инструкций.
+    */
+    VX_TARGET_REF_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_TARGET_EXT) + 0x1,
+    /*
+        Реализация на SSE2 - SSE4.1.
+    */
+    VX_TARGET_SSE_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_TARGET_EXT) + 0x2,
+    /*
+        Реализация на AVX2.
+    */
+    VX_TARGET_AVX2_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_TARGET_EXT) + 0x3,
+};
+
+/*
+    Enum: vx_node_attribute_ext_e
+    Дополнительные атрибуты узла.
+*/
+enum vx_node_attribute_ext_e
+{
+    /*
+        Реализация ядра <vx_target_ext_e>, которую узел получил при проверке
+        графа (только чтение). Поэлементные узлы, слитые при проверке в один
+        проход, исполняются общим кодом слияния и сообщают его реализацию.
+        Используйте vx_enum.
+    */
+    VX_NODE_ATTRIBUTE_TARGET_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_NODE) + 0x0,
+};
+
+/*
+    Enum: vx_image_attribute_ext_e
+    Дополнительные атрибуты изображения.
+*/
+enum vx_image_attribute_ext_e
+{
+    /*
+        Выравнивание данных изображения: наибольшая степень двойки, на которую
+        делятся адреса начала всех строк. Используйте vx_size.
+    */
+    VX_IMAGE_ATTRIBUTE_ALIGNMENT_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_IMAGE) + 0x0,
+    /*
+        Количество байт за концом каждой строки, которые можно читать и
+        перезаписывать. Используйте vx_size.
+    */
+    VX_IMAGE_ATTRIBUTE_PADDING_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_IMAGE) + 0x1,
+    /*
+        Ширина рамки вокруг изображения в пикселях. Используйте vx_uint32.
+    */
+    VX_IMAGE_ATTRIBUTE_BORDER_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_IMAGE) + 0x2,
+};
+
+/*
+    Enum: vx_array_attribute_ext_e
+    Дополнительные атрибуты массива.
+*/
+enum vx_array_attribute_ext_e
+{
+    /*
+        Раскладка элементов <vx_array_layout_ext_e>. По умолчанию
+        VX_ARRAY_LAYOUT_AOS_EXT. Устанавливается <vxSetArrayAttributeExt>,
+        элементы массива при этом переставляются. Используйте vx_enum.
+    */
+    VX_ARRAY_ATTRIBUTE_LAYOUT_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_ARRAY) + 0x0,
+};
+
+/*
+    Enum: vx_array_layout_ext_e
+    Раскладка элементов массива в памяти.
+*/
+enum vx_array_layout_ext_e
+{
+    /*
+        Элементы хранятся подряд (массив структур).
+    */
+    VX_ARRAY_LAYOUT_AOS_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_ARRAY_LAYOUT_EXT) + 0x0,
+    /*
+        Каждое поле элементов хранится отдельным непрерывным массивом
+        (структура массивов), см. <vxAccessArrayFieldExt>. Допустима для
+        элементов из 4-байтовых полей: VX_TYPE_KEYPOINT, VX_TYPE_RECTANGLE,
+        VX_TYPE_COORDINATES2D и VX_TYPE_COORDINATES3D. Отбор и сортировка
+        по одному полю (например, strength) читают только это поле и
+        векторизуются.
+    */
+    VX_ARRAY_LAYOUT_SOA_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_ARRAY_LAYOUT_EXT) + 0x1,
+};
+
+/*
+    Enum: vx_graph_attribute_ext_e
+    Дополнительные атрибуты графа. Атрибуты памяти доступны только для
+    чтения и действительны после проверки графа.
+*/
+enum vx_graph_attribute_ext_e
+{
+    /*
+        Размер памяти, которую занимают виртуальные изображения графа.
+        Изображения, время жизни которых не пересекается, используют одну и
+        ту же память. Виртуальными бывают только изображения
+        (<vxCreateVirtualImage>): vxCreateVirtualArray и vxCreateVirtualPyramid
+        не реализованы, поэтому массивы и пирамиды, которые передаются между
+        узлами, создаются обычными и в этот объём не входят. Используйте vx_size.
+    */
+    VX_GRAPH_ATTRIBUTE_VIRTUAL_MEMORY_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_GRAPH) + 0x0,
+    /*
+        На сколько байт память виртуальных изображений меньше, чем при
+        выделении отдельного буфера каждому изображению. Используйте vx_size.
+    */
+    VX_GRAPH_ATTRIBUTE_VIRTUAL_MEMORY_SAVED_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_GRAPH) + 0x1,
+    /*
+        Глубина конвейера при потоковом исполнении: сколько кадров, переданных
+        <vxEnqueueGraphFrameExt>, могут исполняться одновременно. Каждый кадр
+        получает свою копию виртуальных изображений графа. По умолчанию 1,
+        изменение требует повторной проверки графа. Используйте vx_uint32.
+    */
+    VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_GRAPH) + 0x2,
+    /*
+        Объём данных в байтах, который обрабатывает одна полоса строк при
+        исполнении графа по полосам; разумное значение - размер кэша L2 ядра.
+        Цепочки узлов, которые читают ограниченную окрестность пикселя,
+        исполняются полосами, и промежуточные изображения внутри цепочки не
+        размещаются целиком. 0 (по умолчанию) - каждый узел обрабатывает
+        изображение целиком. Изменение требует повторной проверки графа.
+        Используйте vx_size.
+    */
+    VX_GRAPH_ATTRIBUTE_TILE_SIZE_EXT = VX_ATTRIBUTE_BASE(VX_ID_EXT, VX_TYPE_GRAPH) + 0x3,
+};
+
+/*
+    Enum: vx_point_op_type_ext_e
+    Поэлементные операции над 8-битным изображением, которые можно
+    объединять в цепочку.
+*/
+enum vx_point_op_type_ext_e
+{
+    /*
+        Пороговая обработка, параметр threshold.
+    */
+    VX_POINT_OP_THRESHOLD_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_POINT_OP_EXT) + 0x0,
+    /*
+        Преобразование по таблице, параметр lut (256 элементов).
+    */
+    VX_POINT_OP_TABLE_LOOKUP_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_POINT_OP_EXT) + 0x1,
+    /*
+        Линейное преобразование яркости gain * src + bias.
+    */
+    VX_POINT_OP_CONTRAST_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_POINT_OP_EXT) + 0x2,
+    /*
+        Гамма-коррекция 255 * (src / 255) ^ gamma.
+    */
+    VX_POINT_OP_GAMMA_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_POINT_OP_EXT) + 0x3,
+};
+
+/*
+    Enum: vx_auto_threshold_ext_e
+    Методы автоматического выбора порога по гистограмме изображения.
+*/
+enum vx_auto_threshold_ext_e
+{
+    /*
+        Метод Оцу: порог максимизирует межклассовую дисперсию.
+    */
+    VX_AUTO_THRESHOLD_OTSU_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_AUTO_THRESHOLD_EXT) + 0x0,
+    /*
+        Метод треугольника: порог наиболее удалён от прямой, соединяющей пик
+        гистограммы с концом её длинного хвоста.
+    */
+    VX_AUTO_THRESHOLD_TRIANGLE_EXT = VX_ENUM_BASE(VX_ID_EXT, VX_ENUM_AUTO_THRESHOLD_EXT) + 0x1,
+};
+
+/*
+    Structure: vx_point_op_ext
+    Описание одной операции цепочки. Используются только поля,
+    соответствующие типу операции.
+*/
+typedef struct _vx_point_op_ext
+{
+    //Variable: type
+    //тип операции <vx_point_op_type_ext_e>;
+    vx_enum type;
+    //Variable: threshold
+    //порог для VX_POINT_OP_THRESHOLD_EXT;
+    vx_threshold threshold;
+    //Variable: lut
+    //таблица для VX_POINT_OP_TABLE_LOOKUP_EXT;
+    vx_lut lut;
+    //Variable: gain
+    //коэффициент для VX_POINT_OP_CONTRAST_EXT;
+    vx_float32 gain;
+    //Variable: bias
+    //смещение для VX_POINT_OP_CONTRAST_EXT;
+    vx_float32 bias;
+    //Variable: gamma
+    //показатель для VX_POINT_OP_GAMMA_EXT.
+    vx_float32 gamma;
+} vx_point_op_ext;
+
+/*
+    Function: vxSwapImageHandleExt
+    Заменяет указатели на данные изображения, созданного
+    <vxCreateImageFromHandle>, не пересоздавая изображение. Адресация
+    плоскостей (размеры и шаги) сохраняется. Области изображения, созданные
+    <vxCreateImageFromROI>, продолжают ссылаться на прежние данные.
+
+    Parameters:
+        image      - изображение;
+        new_ptrs   - новые указатели на плоскости (num_planes элементов);
+        prev_ptrs  - если не NULL, сюда записываются прежние указатели;
+        num_planes - количество плоскостей изображения.
+
+    Return:
+        VX_SUCCESS                  - в случае успешного завершения;
+        VX_ERROR_INVALID_REFERENCE  - изображение создано не из указателей;
+        VX_ERROR_INVALID_PARAMETERS - неверное количество плоскостей или
+                                      нулевой указатель.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxSwapImageHandleExt(vx_image image, void* const new_ptrs[], void* prev_ptrs[], vx_size num_planes);
+
+/*
+    Function: vxSetArrayAttributeExt
+    Устанавливает атрибут массива (см. <vx_array_attribute_ext_e>).
+
+    Return:
+        VX_SUCCESS                  - атрибут установлен;
+        VX_ERROR_INVALID_REFERENCE  - arr равен NULL;
+        VX_ERROR_NOT_SUPPORTED      - атрибут не устанавливается или
+                                      раскладка не допустима для типа
+                                      элементов;
+        VX_ERROR_INVALID_PARAMETERS - неверный размер значения;
+        VX_FAILURE                  - к массиву открыто обращение
+                                      <vxAccessArrayRange>;
+        VX_ERROR_NO_MEMORY          - не хватило памяти.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxSetArrayAttributeExt(vx_array arr, vx_enum attribute, const void *ptr, vx_size size);
+
+/*
+    Function: vxAccessArrayFieldExt
+    Возвращает указатель на непрерывный массив значений поля всех элементов
+    массива с раскладкой VX_ARRAY_LAYOUT_SOA_EXT. Данные не копируются и
+    <vxCommitArrayRange> не нужен. Значения можно читать и перезаписывать,
+    включая хвост до количества элементов, округлённого вверх до 16.
+    Указатель действителен до добавления элементов в массив.
+
+    Parameters:
+        arr   - массив;
+        field - номер поля в порядке объявления структуры (для vx_keypoint_t
+                0 - x, 1 - y, 2 - strength, 3 - scale, 4 - orientation,
+                5 - tracking_status, 6 - error);
+        ptr   - сюда записывается указатель на значения поля (выровнен на
+                64 байта).
+
+    Return:
+        VX_SUCCESS                  - указатель получен;
+        VX_ERROR_INVALID_REFERENCE  - arr равен NULL;
+        VX_ERROR_INVALID_PARAMETERS - раскладка не VX_ARRAY_LAYOUT_SOA_EXT,
+                                      неверный номер поля или ptr равен NULL.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxAccessArrayFieldExt(vx_array arr, vx_uint32 field, void **ptr);
+
+/*
+    Function: vxAdaptiveThresholdNodeExt
+    Создаёт узел адаптивной пороговой обработки: пиксель выходного
+    изображения равен 255, если пиксель входного изображения больше среднего
+    по окну block_size x block_size минус offset, иначе 0.
+
+    Parameters:
+        graph      - граф;
+        input      - входное изображение (VX_DF_IMAGE_U8);
+        block_size - размер окна (нечётный, от 3 до 255);
+        offset     - смещение порога относительно среднего;
+        output     - выходное изображение (VX_DF_IMAGE_U8).
+
+    Return:
+        Узел или NULL в случае ошибки.
+*/
+VX_API_ENTRY vx_node VX_API_CALL vxAdaptiveThresholdNodeExt(vx_graph graph, vx_image input, vx_uint32 block_size, vx_int32 offset, vx_image output);
+
+/*
+    Function: vxAutoThresholdNodeExt
+    Создаёт узел пороговой обработки с порогом, выбранным по гистограмме
+    входного изображения. Выбранный порог записывается в thresh, поэтому
+    узлы, читающие thresh, исполняются после этого узла.
+
+    Parameters:
+        graph  - граф;
+        input  - входное изображение (VX_DF_IMAGE_U8);
+        method - метод выбора порога <vx_auto_threshold_ext_e>;
+        thresh - выходной порог с data_type VX_TYPE_INVALID или VX_TYPE_UINT8;
+        output - выходное изображение (VX_DF_IMAGE_U8 или VX_DF_IMAGE_U1_EXT).
+
+    Return:
+        Узел или NULL в случае ошибки.
+*/
+VX_API_ENTRY vx_node VX_API_CALL vxAutoThresholdNodeExt(vx_graph graph, vx_image input, vx_enum method, vx_threshold thresh, vx_image output);
+
+/*
+    Function: vxEnqueueGraphFrameExt
+    Запускает исполнение графа над очередным кадром и возвращает управление
+    сразу. Объекты кадра подставляются вместо параметров графа (см.
+    <vxAddParameterToGraph>) во всех узлах, которые их используют.
+
+    Одновременно исполняются до VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH_EXT кадров,
+    поэтому узлы следующего кадра исполняются, пока завершаются последние
+    узлы предыдущего. При глубине больше 1 каждый объект, который записывают
+    узлы графа, должен быть виртуальным изображением или параметром графа,
+    иначе проверка графа возвращает VX_ERROR_INVALID_GRAPH.
+
+    Кадры передаются и забираются <vxDequeueGraphFrameExt> в одном потоке
+    или под внешней блокировкой.
+
+    Parameters:
+        graph    - граф;
+        refs     - объекты кадра в порядке параметров графа;
+        num_refs - количество параметров графа.
+
+    Return:
+        VX_SUCCESS                  - кадр запущен;
+        VX_ERROR_NO_RESOURCES       - исполняются или не забраны
+                                      VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH_EXT
+                                      кадров;
+        VX_ERROR_INVALID_PARAMETERS - неверное количество объектов, объект
+                                      повторяется, используется графом не как
+                                      параметр или его размеры и формат не
+                                      совпадают с параметром графа;
+        ошибка проверки графа.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxEnqueueGraphFrameExt(vx_graph graph, const vx_reference refs[], vx_uint32 num_refs);
+
+/*
+    Function: vxDequeueGraphFrameExt
+    Ожидает завершения самого раннего из запущенных кадров. Кадры забираются
+    в том порядке, в котором были запущены.
+
+    Parameters:
+        graph    - граф;
+        refs     - если не NULL, сюда записываются объекты кадра;
+        num_refs - количество параметров графа.
+
+    Return:
+        Результат исполнения кадра или VX_FAILURE, если запущенных кадров нет.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxDequeueGraphFrameExt(vx_graph graph, vx_reference refs[], vx_uint32 num_refs);
+
+/*
+    Function: vxFlushLogExt
+    Передаёт накопленные записи журнала обработчику <vxRegisterLogCallback>
+    на вызывающем потоке.
+
+    <vxAddLogEntry> не вызывает обработчик и не форматирует сообщение:
+    формат и аргументы копируются в кольцевой буфер потока без блокировок,
+    а сообщение собирается при выдаче записи. Журнал выдаётся также при
+    проверке графа, по завершении его исполнения (<vxProcessGraph>,
+    <vxWaitGraph>, <vxDequeueGraphFrameExt>) и при смене обработчика.
+    Записи выдаёт один поток за раз, поэтому обработчик не исполняется
+    одновременно на нескольких потоках. Обработчик не должен вызывать
+    <vxRegisterLogCallback>.
+
+    Если до выдачи журнала поток добавил больше 64 записей, лишние записи
+    отбрасываются, а обработчик получает сообщение об их количестве со
+    статусом VX_FAILURE. Аргументы %s копируются; формат и строки записи
+    вместе ограничены примерно 170 символами, аргументов - не больше 8.
+
+    Return:
+        VX_SUCCESS                 - записи выданы или их выдаёт другой поток;
+        VX_ERROR_INVALID_REFERENCE - context равен NULL.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxFlushLogExt(vx_context context);
+
+/*
+    Function: vxAddKernelTargetExt
+    Добавляет ядру ещё одну реализацию: ядру библиотеки или ядру,
+    добавленному <vxAddKernel>. Реализация действует для графов, проверенных
+    после её добавления, и удаляется вместе с контекстом.
+    Узел, получивший такую реализацию, исполняется ею над целыми
+    изображениями: он не сливается с соседними узлами и не делится на полосы.
+
+    Parameters:
+        kernel   - ядро;
+        target   - набор инструкций реализации <vx_target_ext_e>: узел
+                   получает её, только если процессор поддерживает все
+                   наборы цели (для VX_TARGET_SSE_EXT - SSE2, SSSE3 и
+                   SSE4.1, для VX_TARGET_AVX2_EXT - ещё и AVX2);
+        priority - приоритет; реализации библиотеки имеют приоритеты 0
+                   (VX_TARGET_REF_EXT), 1 (VX_TARGET_SSE_EXT) и 2
+                   (VX_TARGET_AVX2_EXT), при равенстве выбирается
+                   добавленная раньше;
+        func_ptr - функция исполнения узла.
+
+    Return:
+        VX_SUCCESS                  - реализация добавлена;
+        VX_ERROR_INVALID_REFERENCE  - kernel равен NULL;
+        VX_ERROR_INVALID_PARAMETERS - неизвестная реализация или func_ptr
+                                      равен NULL;
+        VX_ERROR_NOT_SUPPORTED      - у ядра есть параметры-значения (как
+                                      у AdaptiveThreshold и AutoThreshold),
+                                      которые функция не может прочитать;
+        VX_ERROR_NO_RESOURCES       - у ядра уже 8 реализаций.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxAddKernelTargetExt(vx_kernel kernel, vx_enum target, vx_uint32 priority, vx_kernel_f func_ptr);
+
+#endif // __VX_EXT_H__
@@ -0,0 +1,871 @@
+/*
+    File: kernels.c
+    Содержит описания ядер библиотеки, исполняемых узлами графа: проверку
+    параметров и вызов эталонных реализаций, - и реестр ядер с выбором
+    реализации, включая ядра, добавленные приложением.
+
+    Date: 18 Октября 2026
+*/
+
+#include "ref.h"
+#include "../Common/graph.h"
+#include "../Common/context.h"
+#include "../Common/cpu.h"
+#include "../Common/lut.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define IMAGE_PARAM(node, index) ((vx_image)(node)->params[index])
+
+// Sets the size and format a virtual output left unset, then checks that the
+// output matches the size the kernel produces
+static vx_status ValidateOutput(vx_image output, uint32_t width, uint32_t height, vx_df_image format)
+{
+    if (output->scope)
+    {
+        if (output->width == 0 && output->height == 0)
+        {
+            output->width = width;
+            output->height = height;
+        }
+        if (output->image_type == VX_DF_IMAGE_VIRT)
+            output->image_type = (enum vx_df_image_e)format;
+    }
+
+    if (output->width != width || output->height != height)
+        return VX_ERROR_INVALID_DIMENSION;
+
+    return VX_SUCCESS;
+}
+
+static bool IsBinaryFormat(vx_df_image format)
+{
+    return format == VX_DF_IMAGE_U8 || format == VX_DF_IMAGE_U1_EXT;
+}
+
+// Threshold values are typed as the input pixels; VX_TYPE_INVALID keeps the
+// untyped 255/0 output
+static bool IsThresholdTypeOf(vx_df_image format, vx_enum data_type)
+{
+    switch (format)
+    {
+    case VX_DF_IMAGE_U8:
+        return data_type == VX_TYPE_INVALID || data_type == VX_TYPE_UINT8;
+    case VX_DF_IMAGE_U16:
+        return data_type == VX_TYPE_INVALID || data_type == VX_TYPE_UINT16;
+    case VX_DF_IMAGE_S16:
+        return data_type == VX_TYPE_INVALID || data_type == VX_TYPE_INT16;
+    default:
+        return false;
+    }
+}
+
+// Point operations read only the pixel they write
+static uint32_t HaloNone(vx_node node)
+{
+    (void)node;
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static vx_status ValidateThreshold(vx_node node)
+{
+    const vx_image input = IMAGE_PARAM(node, 0);
+    const vx_threshold thresh = (vx_threshold)node->params[1];
+    vx_image output = IMAGE_PARAM(node, 2);
+
+    if (input->image_type != VX_DF_IMAGE_U8 && input->image_type != VX_DF_IMAGE_U16 && input->image_type != VX_DF_IMAGE_S16)
+        return VX_ERROR_INVALID_FORMAT;
+
+    if (thresh->threshold_type != VX_THRESHOLD_TYPE_BINARY && thresh->threshold_type != VX_THRESHOLD_TYPE_RANGE)
+        return VX_ERROR_INVALID_TYPE;
+
+    if (!IsThresholdTypeOf(input->image_type, thresh->data_type))
+        return VX_ERROR_INVALID_TYPE;
+
+    const vx_status status = ValidateOutput(output, input->width, input->height, VX_DF_IMAGE_U8);
+    if (status != VX_SUCCESS)
+        return status;
+
+    return IsBinaryFormat(output->image_type) ? VX_SUCCESS : VX_ERROR_INVALID_FORMAT;
+}
+
+static vx_status ProcessThreshold(vx_node node)
+{
+    return ref_Threshold(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 2), (vx_threshold)node->params[1]);
+}
+
+static vx_status ValidateTableLookup(vx_node node)
+{
+    const vx_image input = IMAGE_PARAM(node, 0);
+    const vx_lut lut = (vx_lut)node->params[1];
+    vx_image output = IMAGE_PARAM(node, 2);
+
+    if (input->image_type != VX_DF_IMAGE_U8)
+        return VX_ERROR_INVALID_FORMAT;
+
+    if (!lut->data || lut->size != OWN_LUT8_SIZE)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    const vx_status status = ValidateOutput(output, input->width, input->height, VX_DF_IMAGE_U8);
+    if (status != VX_SUCCESS)
+        return status;
+
+    return output->image_type == VX_DF_IMAGE_U8 ? VX_SUCCESS : VX_ERROR_INVALID_FORMAT;
+}
+
+static vx_status ProcessTableLookup(vx_node node)
+{
+    return ref_TableLookup(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 2), (vx_lut)node->params[1]);
+}
+
+static bool PixelThreshold(vx_node node, own_pixel_op* op)
+{
+    if (IMAGE_PARAM(node, 0)->image_type != VX_DF_IMAGE_U8 || IMAGE_PARAM(node, 2)->image_type != VX_DF_IMAGE_U8)
+        return false;
+
+    op->code = OWN_PIXEL_TABLE;
+    return ownLutFromThreshold(op->table, (vx_threshold)node->params[1]) == VX_SUCCESS;
+}
+
+static bool PixelTableLookup(vx_node node, own_pixel_op* op)
+{
+    op->code = OWN_PIXEL_TABLE;
+    memcpy(op->table, ((vx_lut)node->params[1])->data, OWN_LUT8_SIZE);
+    return true;
+}
+
+// And, Or and Xor take two inputs, Not takes one; the output is the last parameter
+static vx_status ValidateBitwise(vx_node node)
+{
+    const uint32_t num_inputs = node->kernel->num_params - 1;
+    const vx_image input = IMAGE_PARAM(node, 0);
+    vx_image output = IMAGE_PARAM(node, num_inputs);
+
+    if (!IsBinaryFormat(input->image_type))
+        return VX_ERROR_INVALID_FORMAT;
+
+    if (num_inputs == 2)
+    {
+        const vx_image input2 = IMAGE_PARAM(node, 1);
+        if (input2->width != input->width || input2->height != input->height)
+            return VX_ERROR_INVALID_DIMENSION;
+        if (input2->image_type != input->image_type)
+            return VX_ERROR_INVALID_FORMAT;
+    }
+
+    const vx_status status = ValidateOutput(output, input->width, input->height, input->image_type);
+    if (status != VX_SUCCESS)
+        return status;
+
+    return output->image_type == input->image_type ? VX_SUCCESS : VX_ERROR_INVALID_FORMAT;
+}
+
+static vx_status ProcessAnd(vx_node node)
+{
+    return ref_And(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 1), IMAGE_PARAM(node, 2));
+}
+
+static vx_status ProcessOr(vx_node node)
+{
+    return ref_Or(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 1), IMAGE_PARAM(node, 2));
+}
+
+static vx_status ProcessXor(vx_node node)
+{
+    return ref_Xor(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 1), IMAGE_PARAM(node, 2));
+}
+
+static vx_status ProcessNot(vx_node node)
+{
+    return ref_Not(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 1));
+}
+
+// Packed binary images hold eight pixels per byte and are not fused
+static bool PixelBitwise(vx_node node, own_pixel_op* op, uint32_t code)
+{
+    if (IMAGE_PARAM(node, 0)->image_type != VX_DF_IMAGE_U8)
+        return false;
+
+    op->code = code;
+    return true;
+}
+
+static bool PixelAnd(vx_node node, own_pixel_op* op)
+{
+    return PixelBitwise(node, op, OWN_PIXEL_AND);
+}
+
+static bool PixelOr(vx_node node, own_pixel_op* op)
+{
+    return PixelBitwise(node, op, OWN_PIXEL_OR);
+}
+
+static bool PixelXor(vx_node node, own_pixel_op* op)
+{
+    return PixelBitwise(node, op, OWN_PIXEL_XOR);
+}
+
+static bool PixelNot(vx_node node, own_pixel_op* op)
+{
+    if (!PixelBitwise(node, op, OWN_PIXEL_TABLE))
+        return false;
+
+    for (uint32_t i = 0; i < OWN_LUT8_SIZE; i++)
+        op->table[i] = (uint8_t)~i;
+    return true;
+}
+
+static vx_status ValidateAdaptiveThreshold(vx_node node)
+{
+    const vx_image input = IMAGE_PARAM(node, 0);
+    const uint32_t block_size = (uint32_t)node->values[1];
+    vx_image output = IMAGE_PARAM(node, 3);
+
+    if (input->image_type != VX_DF_IMAGE_U8)
+        return VX_ERROR_INVALID_FORMAT;
+
+    if (block_size < 3 || block_size > 255 || block_size % 2 == 0)
+        return VX_ERROR_INVALID_VALUE;
+
+    const vx_status status = ValidateOutput(output, input->width, input->height, VX_DF_IMAGE_U8);
+    if (status != VX_SUCCESS)
+        return status;
+
+    return output->image_type == VX_DF_IMAGE_U8 ? VX_SUCCESS : VX_ERROR_INVALID_FORMAT;
+}
+
+static vx_status ProcessAdaptiveThreshold(vx_node node)
+{
+    return ref_AdaptiveThreshold(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 3), (uint32_t)node->values[1], node->values[2]);
+}
+
+static uint32_t HaloAdaptiveThreshold(vx_node node)
+{
+    return (uint32_t)node->values[1] / 2;
+}
+
+static vx_status ValidateAutoThreshold(vx_node node)
+{
+    const vx_image input = IMAGE_PARAM(node, 0);
+    const vx_enum method = node->values[1];
+    vx_image output = IMAGE_PARAM(node, 3);
+
+    if (input->image_type != VX_DF_IMAGE_U8)
+        return VX_ERROR_INVALID_FORMAT;
+
+    if (method != VX_AUTO_THRESHOLD_OTSU_EXT && method != VX_AUTO_THRESHOLD_TRIANGLE_EXT)
+        return VX_ERROR_INVALID_VALUE;
+
+    if (!IsThresholdTypeOf(input->image_type, ((vx_threshold)node->params[2])->data_type))
+        return VX_ERROR_INVALID_TYPE;
+
+    const vx_status status = ValidateOutput(output, input->width, input->height, VX_DF_IMAGE_U8);
+    if (status != VX_SUCCESS)
+        return status;
+
+    return IsBinaryFormat(output->image_type) ? VX_SUCCESS : VX_ERROR_INVALID_FORMAT;
+}
+
+static vx_status ProcessAutoThreshold(vx_node node)
+{
+    return ref_AutoThreshold(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 3), node->values[1], (vx_threshold)node->params[2]);
+}
+
+static vx_status ValidateBox3x3(vx_node node)
+{
+    const vx_image input = IMAGE_PARAM(node, 0);
+    vx_image output = IMAGE_PARAM(node, 1);
+
+    if (input->image_type != VX_DF_IMAGE_U8)
+        return VX_ERROR_INVALID_FORMAT;
+
+    const vx_status status = ValidateOutput(output, input->width, input->height, VX_DF_IMAGE_U8);
+    if (status != VX_SUCCESS)
+        return status;
+
+    return output->image_type == VX_DF_IMAGE_U8 ? VX_SUCCESS : VX_ERROR_INVALID_FORMAT;
+}
+
+static vx_status ProcessBox3x3(vx_node node)
+{
+    return ref_Box3x3(IMAGE_PARAM(node, 0), IMAGE_PARAM(node, 1));
+}
+
+static uint32_t HaloBox3x3(vx_node node)
+{
+    (void)node;
+    return 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+    The library functions pick their SIMD version at run time, so one process
+    function serves every target: the target only caps the instruction sets
+    the node runs with (see ownProcessNode). Only kernels with SIMD rows get
+    SSE and AVX2 entries; the rest are REF_IMPL alone, and a forced target
+    they lack leaves them on it.
+*/
+#define REF_IMPL(process) \
+    { VX_TARGET_REF_EXT, 0, 0, process, NULL }
+
+#define SIMD_IMPLS(process, sse_features) \
+    REF_IMPL(process), \
+    { VX_TARGET_SSE_EXT, 1, sse_features, process, NULL }, \
+    { VX_TARGET_AVX2_EXT, 2, VX_CPU_FEATURE_AVX2, process, NULL }
+
+static struct _vx_kernel g_kernels[] =
+{
+    {
+        VX_KERNEL_THRESHOLD, "org.khronos.openvx.threshold", 3,
+        { VX_INPUT, VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_THRESHOLD, VX_TYPE_IMAGE },
+        ValidateThreshold, { SIMD_IMPLS(ProcessThreshold, VX_CPU_FEATURE_SSE2) }, 3, NULL, HaloNone, PixelThreshold, NULL
+    },
+    {
+        VX_KERNEL_TABLE_LOOKUP, "org.khronos.openvx.table_lookup", 3,
+        { VX_INPUT, VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_LUT, VX_TYPE_IMAGE },
+        ValidateTableLookup, { SIMD_IMPLS(ProcessTableLookup, VX_CPU_FEATURE_SSSE3) }, 3, NULL, HaloNone, PixelTableLookup, NULL
+    },
+    {
+        VX_KERNEL_AND, "org.khronos.openvx.and", 3,
+        { VX_INPUT, VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_IMAGE, VX_TYPE_IMAGE },
+        ValidateBitwise, { REF_IMPL(ProcessAnd) }, 1, NULL, HaloNone, PixelAnd, NULL
+    },
+    {
+        VX_KERNEL_OR, "org.khronos.openvx.or", 3,
+        { VX_INPUT, VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_IMAGE, VX_TYPE_IMAGE },
+        ValidateBitwise, { REF_IMPL(ProcessOr) }, 1, NULL, HaloNone, PixelOr, NULL
+    },
+    {
+        VX_KERNEL_XOR, "org.khronos.openvx.xor", 3,
+        { VX_INPUT, VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_IMAGE, VX_TYPE_IMAGE },
+        ValidateBitwise, { REF_IMPL(ProcessXor) }, 1, NULL, HaloNone, PixelXor, NULL
+    },
+    {
+        VX_KERNEL_NOT, "org.khronos.openvx.not", 2,
+        { VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_IMAGE },
+        ValidateBitwise, { REF_IMPL(ProcessNot) }, 1, NULL, HaloNone, PixelNot, NULL
+    },
+    {
+        VX_KERNEL_ADAPTIVE_THRESHOLD_EXT, "org.openvx_ext.adaptive_threshold", 4,
+        { VX_INPUT, VX_INPUT, VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_UINT32, VX_TYPE_INT32, VX_TYPE_IMAGE },
+        ValidateAdaptiveThreshold, { REF_IMPL(ProcessAdaptiveThreshold) }, 1, NULL, HaloAdaptiveThreshold, NULL, NULL
+    },
+    {
+        VX_KERNEL_AUTO_THRESHOLD_EXT, "org.openvx_ext.auto_threshold", 4,
+        { VX_INPUT, VX_INPUT, VX_OUTPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_ENUM, VX_TYPE_THRESHOLD, VX_TYPE_IMAGE },
+        ValidateAutoThreshold, { SIMD_IMPLS(ProcessAutoThreshold, VX_CPU_FEATURE_SSE2) }, 3, NULL, NULL, NULL, NULL
+    },
+    {
+        VX_KERNEL_BOX_3x3, "org.khronos.openvx.box_3x3", 2,
+        { VX_INPUT, VX_OUTPUT },
+        { VX_TYPE_IMAGE, VX_TYPE_IMAGE },
+        ValidateBox3x3, { REF_IMPL(ProcessBox3x3) }, 1, NULL, HaloBox3x3, NULL, NULL
+    },
+};
+
+#define NUM_LIBRARY_KERNELS (sizeof(g_kernels) / sizeof(g_kernels[0]))
+
+vx_kernel ownGetLibraryKernel(vx_enum kernel)
+{
+    for (size_t i = 0; i < NUM_LIBRARY_KERNELS; i++)
+    {
+        if (g_kernels[i].enumeration == kernel)
+            return &g_kernels[i];
+    }
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Instruction sets a node may use on the target; an implementation the
+// application adds for the target needs all of them
+static uint32_t GetTargetMask(vx_enum target)
+{
+    switch (target)
+    {
+    case VX_TARGET_REF_EXT:
+        return 0;
+    case VX_TARGET_SSE_EXT:
+        return VX_CPU_FEATURE_SSE2 | VX_CPU_FEATURE_SSSE3 | VX_CPU_FEATURE_SSE41;
+    case VX_TARGET_AVX2_EXT:
+        return VX_CPU_FEATURE_SSE2 | VX_CPU_FEATURE_SSSE3 | VX_CPU_FEATURE_SSE41 | VX_CPU_FEATURE_AVX2;
+    default:
+        return ~0u;
+    }
+}
+
+vx_status ownSelectKernelImpl(vx_node node)
+{
+    const vx_kernel kernel = node->kernel;
+    const vx_context context = node->graph->context;
+    const uint32_t features = ownGetCpuFeatures();
+
+    const own_kernel_impl* best = NULL;
+    const own_kernel_impl* forced = NULL;
+
+    ownSpinLock(&context->kernel_lock);
+    for (uint32_t i = 0; i < kernel->num_impls; i++)
+    {
+        const own_kernel_impl* impl = &kernel->impls[i];
+        if (impl->features & ~features)
+            continue;
+
+        if (!best || impl->priority > best->priority)
+            best = impl;
+        // under VX_TARGET_ANY_EXT nothing is forced, priorities alone decide
+        if (context->target != VX_TARGET_ANY_EXT && impl->target == context->target &&
+            (!forced || impl->priority > forced->priority))
+            forced = impl;
+    }
+    if (forced)
+        best = forced;
+    if (best)
+        node->impl = *best;
+    ownSpinUnlock(&context->kernel_lock);
+
+    return best ? VX_SUCCESS : VX_ERROR_NOT_SUPPORTED;
+}
+
+vx_status ownProcessNode(vx_node node)
+{
+    const own_kernel_impl* impl = &node->impl;
+    const uint32_t mask = ownSetCpuFeatureMask(GetTargetMask(impl->target));
+
+    const vx_status status = impl->function ?
+        impl->function(node, node->params, node->kernel->num_params) : impl->process(node);
+
+    ownSetCpuFeatureMask(mask);
+    return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+    A kernel added by vxAddKernel: the kernel comes first, so a vx_kernel of
+    the context list points at its UserKernel. The validators of the
+    application run from ValidateUser, in the order the graph validates nodes.
+*/
+typedef struct
+{
+    struct _vx_kernel kernel;
+    char name[VX_MAX_KERNEL_NAME];
+    vx_kernel_input_validate_f input;
+    vx_kernel_output_validate_f output;
+    vx_kernel_initialize_f initialize;
+    vx_kernel_deinitialize_f deinitialize;
+    // bit per parameter described by vxAddParameterToKernel
+    uint32_t described;
+    uint32_t finalized;
+} UserKernel;
+
+// What an output validator says its output has to be
+struct _vx_meta_format
+{
+    vx_enum type;
+    vx_df_image format;
+    vx_uint32 width;
+    vx_uint32 height;
+};
+
+static vx_status ValidateUser(vx_node node);
+
+static bool IsUserKernel(const vx_kernel kernel)
+{
+    return kernel->validate == ValidateUser;
+}
+
+static vx_status ValidateUser(vx_node node)
+{
+    const UserKernel* user = (const UserKernel*)node->kernel;
+    const uint32_t num_params = user->kernel.num_params;
+
+    for (uint32_t p = 0; p < num_params; p++)
+    {
+        if (user->kernel.directions[p] != VX_INPUT)
+            continue;
+
+        const vx_status status = user->input(node, p);
+        if (status != VX_SUCCESS)
+            return status;
+    }
+
+    for (uint32_t p = 0; p < num_params; p++)
+    {
+        if (user->kernel.directions[p] != VX_OUTPUT)
+            continue;
+
+        struct _vx_meta_format meta;
+        meta.type = user->kernel.types[p];
+        meta.format = VX_DF_IMAGE_VIRT;
+        meta.width = 0;
+        meta.height = 0;
+
+        vx_status status = user->output(node, p, &meta);
+        if (status != VX_SUCCESS)
+            return status;
+        if (meta.type != VX_TYPE_IMAGE)
+            continue;
+
+        vx_image output = IMAGE_PARAM(node, p);
+        status = ValidateOutput(output, meta.width, meta.height, meta.format);
+        if (status != VX_SUCCESS)
+            return status;
+        if (output->image_type != meta.format)
+            return VX_ERROR_INVALID_FORMAT;
+    }
+
+    if (user->initialize)
+    {
+        const vx_status status = user->initialize(node, node->params, num_params);
+        if (status != VX_SUCCESS)
+            return status;
+    }
+    node->initialized = 1;
+    return VX_SUCCESS;
+}
+
+static vx_status DeinitializeUser(vx_node node)
+{
+    const UserKernel* user = (const UserKernel*)node->kernel;
+    return user->deinitialize(node, node->params, user->kernel.num_params);
+}
+
+// Kernels of the context list are found only once finalized, unless all is set
+static vx_kernel FindKernel(vx_context context, vx_enum enumeration, const char* name, bool all)
+{
+    for (size_t i = 0; i < NUM_LIBRARY_KERNELS; i++)
+    {
+        if (g_kernels[i].enumeration == enumeration || (name && strncmp(g_kernels[i].name, name, VX_MAX_KERNEL_NAME) == 0))
+            return &g_kernels[i];
+    }
+
+    for (vx_kernel kernel = context->kernels; kernel; kernel = kernel->next)
+    {
+        if (!all && !((const UserKernel*)kernel)->finalized)
+            continue;
+        if (kernel->enumeration == enumeration || (name && strncmp(kernel->name, name, VX_MAX_KERNEL_NAME) == 0))
+            return kernel;
+    }
+    return NULL;
+}
+
+static bool IsContext(vx_context context)
+{
+    return context && context == ownGetContext();
+}
+
+void ownReleaseKernels(vx_context context)
+{
+    ownSpinLock(&context->kernel_lock);
+
+    while (context->kernels)
+    {
+        vx_kernel next = context->kernels->next;
+        free(context->kernels);
+        context->kernels = next;
+    }
+
+    // the library kernels outlive the context, the implementations added to them do not
+    for (size_t i = 0; i < NUM_LIBRARY_KERNELS; i++)
+    {
+        struct _vx_kernel* kernel = &g_kernels[i];
+        uint32_t count = 0;
+        for (uint32_t k = 0; k < kernel->num_impls; k++)
+        {
+            if (!kernel->impls[k].function)
+                kernel->impls[count++] = kernel->impls[k];
+        }
+        kernel->num_impls = count;
+    }
+
+    ownSpinUnlock(&context->kernel_lock);
+}
+
+VX_API_ENTRY vx_kernel VX_API_CALL vxGetKernelByName(vx_context context, const vx_char *name)
+{
+    if (!IsContext(context) || !name)
+        return NULL;
+
+    ownSpinLock(&context->kernel_lock);
+    const vx_kernel kernel = FindKernel(context, VX_KERNEL_INVALID, name, false);
+    ownSpinUnlock(&context->kernel_lock);
+    return kernel;
+}
+
+VX_API_ENTRY vx_kernel VX_API_CALL vxGetKernelByEnum(vx_context context, vx_enum kernel)
+{
+    if (!IsContext(context) || kernel == VX_KERNEL_INVALID)
+        return NULL;
+
+    ownSpinLock(&context->kernel_lock);
+    const vx_kernel found = FindKernel(context, kernel, NULL, false);
+    ownSpinUnlock(&context->kernel_lock);
+    return found;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxQueryKernel(vx_kernel kernel, vx_enum attribute, void *ptr, vx_size size)
+{
+    if (!kernel)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    switch (attribute)
+    {
+    case VX_KERNEL_ATTRIBUTE_PARAMETERS:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_uint32*)ptr = kernel->num_params;
+        return VX_SUCCESS;
+
+    case VX_KERNEL_ATTRIBUTE_NAME:
+    {
+        const size_t length = strlen(kernel->name);
+        if (size <= length)
+            return VX_ERROR_INVALID_PARAMETERS;
+        memcpy(ptr, kernel->name, length + 1);
+        return VX_SUCCESS;
+    }
+
+    case VX_KERNEL_ATTRIBUTE_ENUM:
+        if (size != sizeof(vx_enum))
+            return VX_ERROR_INVALID_PARAMETERS;
+        *(vx_enum*)ptr = kernel->enumeration;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+// Kernels belong to the library or to the context and are freed with it
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseKernel(vx_kernel *kernel)
+{
+    if (!kernel || !*kernel)
+        return VX_ERROR_INVALID_REFERENCE;
+
+    *kernel = NULL;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_kernel VX_API_CALL vxAddKernel(vx_context context,
+                             const vx_char name[VX_MAX_KERNEL_NAME],
+                             vx_enum enumeration,
+                             vx_kernel_f func_ptr,
+                             vx_uint32 numParams,
+                             vx_kernel_input_validate_f input,
+                             vx_kernel_output_validate_f output,
+                             vx_kernel_initialize_f init,
+                             vx_kernel_deinitialize_f deinit)
+{
+    if (!IsContext(context) || !name || !name[0] || !func_ptr || !input || !output)
+        return NULL;
+    if (enumeration == VX_KERNEL_INVALID || numParams > OWN_MAX_KERNEL_PARAMS)
+        return NULL;
+
+    UserKernel* user = (UserKernel*)calloc(1, sizeof(UserKernel));
+    if (!user)
+        return NULL;
+
+    size_t length = 0;
+    while (length + 1 < VX_MAX_KERNEL_NAME && name[length])
+        length++;
+    memcpy(user->name, name, length);
+    user->input = input;
+    user->output = output;
+    user->initialize = init;
+    user->deinitialize = deinit;
+
+    vx_kernel kernel = &user->kernel;
+    kernel->enumeration = enumeration;
+    kernel->name = user->name;
+    kernel->num_params = numParams;
+    kernel->validate = ValidateUser;
+    kernel->impls[0].target = VX_TARGET_ANY_EXT;
+    kernel->impls[0].function = func_ptr;
+    kernel->num_impls = 1;
+    kernel->deinitialize = deinit ? DeinitializeUser : NULL;
+
+    ownSpinLock(&context->kernel_lock);
+    const bool exists = FindKernel(context, enumeration, user->name, true) != NULL;
+    if (!exists)
+    {
+        kernel->next = context->kernels;
+        context->kernels = kernel;
+    }
+    ownSpinUnlock(&context->kernel_lock);
+
+    if (exists)
+    {
+        free(user);
+        return NULL;
+    }
+    return kernel;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxAddParameterToKernel(vx_kernel kernel, vx_uint32 index, vx_enum dir, vx_enum data_type, vx_enum state)
+{
+    if (!kernel || !IsUserKernel(kernel))
+        return VX_ERROR_INVALID_REFERENCE;
+
+    UserKernel* user = (UserKernel*)kernel;
+    if (user->finalized || index >= kernel->num_params || (dir != VX_INPUT && dir != VX_OUTPUT))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    // a generic node gets objects only, and the order and memory of the graph
+    // are planned with every object in place
+    if (data_type == VX_TYPE_INT32 || data_type == VX_TYPE_UINT32 || data_type == VX_TYPE_ENUM)
+        return VX_ERROR_NOT_SUPPORTED;
+    if (state != VX_PARAMETER_STATE_REQUIRED)
+        return VX_ERROR_NOT_SUPPORTED;
+
+    kernel->directions[index] = dir;
+    kernel->types[index] = data_type;
+    user->described |= 1u << index;
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxFinalizeKernel(vx_kernel kernel)
+{
+    if (!kernel || !IsUserKernel(kernel))
+        return VX_ERROR_INVALID_REFERENCE;
+
+    UserKernel* user = (UserKernel*)kernel;
+    if (user->described != (1u << kernel->num_params) - 1)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    vx_context context = ownGetContext();
+    ownSpinLock(&context->kernel_lock);
+    user->finalized = 1;
+    ownSpinUnlock(&context->kernel_lock);
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxRemoveKernel(vx_kernel kernel)
+{
+    if (!kernel)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!IsUserKernel(kernel) || ((const UserKernel*)kernel)->finalized)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    vx_context context = ownGetContext();
+    ownSpinLock(&context->kernel_lock);
+    vx_kernel* link = &context->kernels;
+    while (*link && *link != kernel)
+        link = &(*link)->next;
+    if (*link)
+        *link = kernel->next;
+    ownSpinUnlock(&context->kernel_lock);
+
+    free(kernel);
+    return VX_SUCCESS;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxAddKernelTargetExt(vx_kernel kernel, vx_enum target, vx_uint32 priority, vx_kernel_f func_ptr)
+{
+    if (!kernel)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!func_ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    // values are kept in the node, not as references an added function could read
+    for (uint32_t p = 0; p < kernel->num_params; p++)
+    {
+        const vx_enum type = kernel->types[p];
+        if (type == VX_TYPE_INT32 || type == VX_TYPE_UINT32 || type == VX_TYPE_ENUM)
+            return VX_ERROR_NOT_SUPPORTED;
+    }
+
+    own_kernel_impl impl;
+    impl.target = target;
+    impl.priority = priority;
+    impl.process = NULL;
+    impl.function = func_ptr;
+    switch (target)
+    {
+    case VX_TARGET_ANY_EXT:
+        impl.features = 0;
+        break;
+    case VX_TARGET_REF_EXT:
+    case VX_TARGET_SSE_EXT:
+    case VX_TARGET_AVX2_EXT:
+        impl.features = GetTargetMask(target);
+        break;
+    default:
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    vx_status status = VX_SUCCESS;
+    vx_context context = ownGetContext();
+    ownSpinLock(&context->kernel_lock);
+    if (kernel->num_impls < OWN_MAX_KERNEL_IMPLS)
+        kernel->impls[kernel->num_impls++] = impl;
+    else
+        status = VX_ERROR_NO_RESOURCES;
+    ownSpinUnlock(&context->kernel_lock);
+    return status;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetMetaFormatAttribute(vx_meta_format meta, vx_enum attribute, const void *ptr, vx_size size)
+{
+    if (!meta)
+        return VX_ERROR_INVALID_REFERENCE;
+    if (!ptr)
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (meta->type != VX_TYPE_IMAGE)
+        return VX_ERROR_NOT_SUPPORTED;
+
+    switch (attribute)
+    {
+    case VX_IMAGE_ATTRIBUTE_FORMAT:
+        if (size != sizeof(vx_df_image))
+            return VX_ERROR_INVALID_PARAMETERS;
+        meta->format = *(const vx_df_image*)ptr;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_WIDTH:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        meta->width = *(const vx_uint32*)ptr;
+        return VX_SUCCESS;
+
+    case VX_IMAGE_ATTRIBUTE_HEIGHT:
+        if (size != sizeof(vx_uint32))
+            return VX_ERROR_INVALID_PARAMETERS;
+        meta->height = *(const vx_uint32*)ptr;
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+}
+
+// The parameters are set by vxSetParameterByIndex; values cannot be, so
+// kernels with value parameters need their own node function
+VX_API_ENTRY vx_node VX_API_CALL vxCreateGenericNode(vx_graph graph, vx_kernel kernel)
+{
+    if (!graph || !kernel)
+        return NULL;
+    if (IsUserKernel(kernel) && !((const UserKernel*)kernel)->finalized)
+        return NULL;
+
+    for (uint32_t p = 0; p < kernel->num_params; p++)
+    {
+        if (kernel->types[p] == VX_TYPE_INT32 || kernel->types[p] == VX_TYPE_UINT32 || kernel->types[p] == VX_TYPE_ENUM)
+            return NULL;
+    }
+
+    return ownCreateNode(graph, kernel, NULL, NULL);
+}
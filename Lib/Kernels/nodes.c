@@ -0,0 +1,97 @@
+/*
+    File: nodes.c
+    Содержит функции создания узлов графа для ядер библиотеки.
+
+    Date: 18 Октября 2026
+*/
+
+#include "ref.h"
+#include "../Common/graph.h"
+
+static vx_node CreateNode(vx_graph graph, vx_enum kernel, const vx_reference* refs, const vx_int32* values)
+{
+    return ownCreateNode(graph, ownGetLibraryKernel(kernel), refs, values);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxThresholdNode(vx_graph graph, vx_image input, vx_threshold thresh, vx_image output)
+{
+    vx_reference refs[3];
+    refs[0] = (vx_reference)input;
+    refs[1] = (vx_reference)thresh;
+    refs[2] = (vx_reference)output;
+    return CreateNode(graph, VX_KERNEL_THRESHOLD, refs, NULL);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxTableLookupNode(vx_graph graph, vx_image input, vx_lut lut, vx_image output)
+{
+    vx_reference refs[3];
+    refs[0] = (vx_reference)input;
+    refs[1] = (vx_reference)lut;
+    refs[2] = (vx_reference)output;
+    return CreateNode(graph, VX_KERNEL_TABLE_LOOKUP, refs, NULL);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxAndNode(vx_graph graph, vx_image in1, vx_image in2, vx_image out)
+{
+    vx_reference refs[3];
+    refs[0] = (vx_reference)in1;
+    refs[1] = (vx_reference)in2;
+    refs[2] = (vx_reference)out;
+    return CreateNode(graph, VX_KERNEL_AND, refs, NULL);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxOrNode(vx_graph graph, vx_image in1, vx_image in2, vx_image out)
+{
+    vx_reference refs[3];
+    refs[0] = (vx_reference)in1;
+    refs[1] = (vx_reference)in2;
+    refs[2] = (vx_reference)out;
+    return CreateNode(graph, VX_KERNEL_OR, refs, NULL);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxXorNode(vx_graph graph, vx_image in1, vx_image in2, vx_image out)
+{
+    vx_reference refs[3];
+    refs[0] = (vx_reference)in1;
+    refs[1] = (vx_reference)in2;
+    refs[2] = (vx_reference)out;
+    return CreateNode(graph, VX_KERNEL_XOR, refs, NULL);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxNotNode(vx_graph graph, vx_image input, vx_image output)
+{
+    vx_reference refs[2];
+    refs[0] = (vx_reference)input;
+    refs[1] = (vx_reference)output;
+    return CreateNode(graph, VX_KERNEL_NOT, refs, NULL);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxBox3x3Node(vx_graph graph, vx_image input, vx_image output)
+{
+    vx_reference refs[2];
+    refs[0] = (vx_reference)input;
+    refs[1] = (vx_reference)output;
+    return CreateNode(graph, VX_KERNEL_BOX_3x3, refs, NULL);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxAdaptiveThresholdNodeExt(vx_graph graph, vx_image input, vx_uint32 block_size, vx_int32 offset, vx_image output)
+{
+    vx_reference refs[4];
+    vx_int32 values[4];
+    refs[0] = (vx_reference)input;
+    refs[3] = (vx_reference)output;
+    values[1] = (vx_int32)block_size;
+    values[2] = offset;
+    return CreateNode(graph, VX_KERNEL_ADAPTIVE_THRESHOLD_EXT, refs, values);
+}
+
+VX_API_ENTRY vx_node VX_API_CALL vxAutoThresholdNodeExt(vx_graph graph, vx_image input, vx_enum method, vx_threshold thresh, vx_image output)
+{
+    vx_reference refs[4];
+    vx_int32 values[4];
+    refs[0] = (vx_reference)input;
+    refs[2] = (vx_reference)thresh;
+    refs[3] = (vx_reference)output;
+    values[1] = method;
+    return CreateNode(graph, VX_KERNEL_AUTO_THRESHOLD_EXT, refs, values);
+}
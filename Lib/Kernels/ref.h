@@ -18,6 +18,7 @@
 #include "../Common/openvx/vx_types.h"
 
 #include "../Common/types.h"
+#include "../Common/vx_ext.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 //                    ПРИМЕР РЕАЛИЗОВАННОЙ ФУНКЦИИ
@@ -33,13 +34,20 @@
     пикселя больше верхнего порога и меньше нижнего, то значение соответствующего пикселя выходного изображения
     устанавливается в 0, иначе в 255
 
+    Входное изображение может иметь формат VX_DF_IMAGE_U8, VX_DF_IMAGE_U16 или
+    VX_DF_IMAGE_S16. Если в пороге задан тип данных, вместо 255 и 0
+    записываются его значения true_value и false_value (см. <_vx_threshold>).
+
     Parameters:
         src_image           - входное изображение;
-        dst_image           - выходное изображение;
-        thresh              - структура, состоящая из трёх полей:
+        dst_image           - выходное изображение (VX_DF_IMAGE_U8 или упакованное
+                              бинарное VX_DF_IMAGE_U1_EXT, для которого значения
+                              true/false всегда 1/0);
+        thresh              - структура, состоящая из полей:
         - значение порога для binary (value);
         - значение верхнего порога для range (upper_thresholding);
-        - значение нижнего порога для range (lower_thresholding).
+        - значение нижнего порога для range (lower_thresholding);
+        - тип данных порога и выходные значения (data_type, true_value, false_value).
 
     Return:
         VX_SUCCESS          - в случае успешного завершения;
@@ -47,6 +55,47 @@
 */
 vx_status ref_Threshold(const vx_image src_image, vx_image dst_image, const vx_threshold thresh);
 
+/*
+    Function: ref_AdaptiveThreshold
+    Адаптивная пороговая обработка. Пиксель выходного изображения
+    устанавливается в 255, если яркость пикселя больше среднего по окну
+    block_size x block_size с центром в этом пикселе минус offset, иначе в 0.
+    За границей изображения повторяются крайние пиксели. Время обработки
+    пикселя не зависит от размера окна.
+
+    Parameters:
+        src_image           - входное изображение (VX_DF_IMAGE_U8);
+        dst_image           - выходное изображение (VX_DF_IMAGE_U8);
+        block_size          - размер окна, нечётное число от 3 до 255;
+        offset              - величина, вычитаемая из среднего.
+
+    Return:
+        VX_SUCCESS          - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных;
+        VX_ERROR_NO_MEMORY  - не удалось выделить память.
+*/
+vx_status ref_AdaptiveThreshold(const vx_image src_image, vx_image dst_image, const uint32_t block_size, const int32_t offset);
+
+/*
+    Function: ref_AutoThreshold
+    Бинарная пороговая обработка с порогом, выбранным по гистограмме
+    изображения методом Оцу или методом треугольника. Гистограмма строится
+    параллельно, затем изображение обрабатывается как в <ref_Threshold>.
+
+    Parameters:
+        src_image           - входное изображение (VX_DF_IMAGE_U8);
+        dst_image           - выходное изображение (VX_DF_IMAGE_U8);
+        method              - метод выбора порога <vx_auto_threshold_ext_e>;
+        thresh              - выходной порог: тип Binary и выбранное значение value;
+                              data_type должен быть VX_TYPE_INVALID или VX_TYPE_UINT8
+                              и, как в <ref_Threshold>, задаёт выходные значения.
+
+    Return:
+        VX_SUCCESS          - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных.
+*/
+vx_status ref_AutoThreshold(const vx_image src_image, vx_image dst_image, const vx_enum method, vx_threshold thresh);
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
@@ -63,15 +112,111 @@ vx_status ref_Threshold(const vx_image src_image, vx_image dst_image, const vx_t
 		uniqueness_threshold - минимальное значение уникальности при сопоставлении блоков. Увеличение этого параметра 
 			приведет к увеличению точек, для которых будет считаться, что смещение (disparity) посчитано ненадежно.
 			Значение 0 отключит проверку на уникальность.
+
+	Граница изображения обрабатывается по VX_CONTEXT_ATTRIBUTE_IMMEDIATE_BORDER_MODE. При
+	VX_BORDER_MODE_UNDEFINED (по умолчанию) пикселы, блок которых выходит за изображение, не изменяются.
+	При VX_BORDER_MODE_REPLICATE и VX_BORDER_MODE_CONSTANT блоки у границы дополняются по режиму
+	границы, и смещение вычисляется для всех пикселов со столбца max_disparity.
 		
 	Return:
 		VX_SUCCESS                  - в случае успешного завершения;
-		VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных.
+		VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных;
+		VX_ERROR_NO_MEMORY          - не удалось выделить память.
 */
 vx_status ref_DisparityMap(
 	const vx_image left_image, const vx_image right_image, vx_image disparity_image,
 	const uint32_t block_size, const int16_t max_disparity, const uint32_t uniqueness_threshold);
 
+/*
+    Function: ref_TableLookup
+    Преобразование 8-битного изображения по таблице: dst = lut[src].
+
+    Parameters:
+        src_image           - входное изображение (VX_DF_IMAGE_U8);
+        dst_image           - выходное изображение (VX_DF_IMAGE_U8);
+        lut                 - таблица из 256 элементов.
+
+    Return:
+        VX_SUCCESS          - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных.
+*/
+vx_status ref_TableLookup(const vx_image src_image, vx_image dst_image, const vx_lut lut);
+
+/*
+    Function: ref_PointOps
+    Последовательное применение цепочки поэлементных операций (порог, таблица,
+    контраст, гамма) к 8-битному изображению. Цепочка сворачивается в одну
+    таблицу, поэтому её стоимость не зависит от количества операций.
+
+    Parameters:
+        src_image           - входное изображение (VX_DF_IMAGE_U8);
+        dst_image           - выходное изображение (VX_DF_IMAGE_U8);
+        ops                 - операции в порядке применения;
+        num_ops             - количество операций (0 - копирование).
+
+    Return:
+        VX_SUCCESS          - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных.
+*/
+vx_status ref_PointOps(const vx_image src_image, vx_image dst_image, const vx_point_op_ext* ops, uint32_t num_ops);
+
+/*
+    Functions: ref_And, ref_Or, ref_Xor, ref_Not
+    Побитовые операции над изображениями VX_DF_IMAGE_U8 или упакованными
+    бинарными изображениями VX_DF_IMAGE_U1_EXT. Все изображения должны иметь
+    одинаковые размеры и формат.
+
+    Parameters:
+        src1_image, src2_image - входные изображения (src_image для ref_Not);
+        dst_image              - выходное изображение.
+
+    Return:
+        VX_SUCCESS          - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных.
+*/
+vx_status ref_And(const vx_image src1_image, const vx_image src2_image, vx_image dst_image);
+vx_status ref_Or(const vx_image src1_image, const vx_image src2_image, vx_image dst_image);
+vx_status ref_Xor(const vx_image src1_image, const vx_image src2_image, vx_image dst_image);
+vx_status ref_Not(const vx_image src_image, vx_image dst_image);
+
+/*
+    Function: ref_Box3x3
+    Усредняющий фильтр: пиксель выходного изображения равен среднему
+    (с округлением вниз) по окну 3x3 с центром в этом пикселе. За границей
+    изображения повторяются крайние пиксели.
+
+    Parameters:
+        src_image           - входное изображение (VX_DF_IMAGE_U8);
+        dst_image           - выходное изображение (VX_DF_IMAGE_U8).
+
+    Return:
+        VX_SUCCESS          - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных;
+        VX_ERROR_NO_MEMORY  - не удалось выделить память.
+*/
+vx_status ref_Box3x3(const vx_image src_image, vx_image dst_image);
+
+/*
+    Function: ref_GaussianPyramid
+    Гауссова пирамида: нулевой уровень - копия входного изображения, каждый
+    следующий уровень получается фильтром Гаусса 5x5 предыдущего уровня и
+    выборкой пикселов с шагом 1 / scale. Все уровни строятся за один проход по
+    входному изображению: строка уровня вычисляется, как только готовы строки
+    предыдущего уровня под её окном. Граница обрабатывается по
+    VX_CONTEXT_ATTRIBUTE_IMMEDIATE_BORDER_MODE (VX_BORDER_MODE_UNDEFINED
+    обрабатывается как VX_BORDER_MODE_REPLICATE).
+
+    Parameters:
+        src_image           - входное изображение (VX_DF_IMAGE_U8);
+        dst_pyramid         - выходная пирамида (VX_DF_IMAGE_U8) размера входного изображения.
+
+    Return:
+        VX_SUCCESS          - в случае успешного завершения;
+        VX_ERROR_INVALID_PARAMETERS - в случае некорректных данных;
+        VX_ERROR_NO_MEMORY  - не удалось выделить память.
+*/
+vx_status ref_GaussianPyramid(const vx_image src_image, vx_pyramid dst_pyramid);
+
 /*
     Function: ref_ConnectedComponentsLabeling
 
@@ -0,0 +1,178 @@
+/*
+    File: ref_AdaptiveThreshold.c
+    Содержит эталонную реализацию адаптивной пороговой обработки.
+
+    Date: 18 Октября 2026
+*/
+
+#include "../ref.h"
+#include "../../Common/image.h"
+#include "../../Common/border.h"
+#include "../../Common/parallel.h"
+#include "../../Common/context.h"
+
+#define ADAPTIVE_MAX_BLOCK_SIZE 255
+#define ADAPTIVE_MAX_OFFSET     UINT8_MAX
+
+/*
+    Window sums come from running box sums: every band of rows keeps the
+    vertical sums of block_size rows for each column and slides them down one
+    row at a time, then a horizontal running sum over those columns gives the
+    window sum. The cost per pixel does not depend on block_size. Rows and
+    columns outside the image replicate the nearest edge, so every window has
+    block_size * block_size pixels.
+
+    A band starts by summing block_size rows, so bands are made several
+    windows tall to keep that start-up cost small.
+*/
+#define ADAPTIVE_BAND_WINDOWS 4
+
+typedef struct
+{
+    vx_image src_image;
+    vx_image dst_image;
+    uint32_t width;
+    uint32_t height;
+    uint32_t radius;
+    int32_t offset;
+    uint32_t band_rows;
+    volatile int32_t out_of_memory;
+} AdaptiveArgs;
+
+static const uint8_t* SourceRow(const AdaptiveArgs* args, int32_t y, uint8_t* buffer)
+{
+    vx_border_mode_t border;
+    border.mode = VX_BORDER_MODE_REPLICATE;
+    border.constant_value = 0;
+    return (const uint8_t*)ownGetBorderRow(args->src_image, y, &border, NULL, buffer);
+}
+
+static void FillPadding(uint32_t* columns, uint32_t width, uint32_t radius)
+{
+    // columns[radius .. radius + width) hold the image columns
+    for (uint32_t i = 0; i < radius; i++)
+    {
+        columns[i] = columns[radius];
+        columns[radius + width + i] = columns[radius + width - 1];
+    }
+}
+
+static void ThresholdRow(const AdaptiveArgs* args, const uint32_t* columns, uint32_t y, uint8_t* buffers)
+{
+    const uint8_t* src = (const uint8_t*)ownLoadRow(args->src_image, y, buffers);
+    uint8_t* dst = (uint8_t*)ownGetRowOutput(args->dst_image, y, buffers + args->width);
+    const uint32_t block_size = 2 * args->radius + 1;
+    const int32_t area = (int32_t)(block_size * block_size);
+    const int32_t bias = args->offset * area;
+
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < block_size; i++)
+        sum += columns[i];
+
+    for (uint32_t x = 0; x < args->width; x++)
+    {
+        // src > sum / area - offset, without the division
+        dst[x] = (int32_t)src[x] * area + bias > (int32_t)sum ? UINT8_MAX : 0;
+
+        sum += columns[x + block_size];
+        sum -= columns[x];
+    }
+
+    ownStoreRow(args->dst_image, y, dst);
+}
+
+static void AdaptiveBands(void* data, uint32_t band_begin, uint32_t band_end)
+{
+    AdaptiveArgs* args = (AdaptiveArgs*)data;
+    const uint32_t width = args->width;
+    const int32_t radius = (int32_t)args->radius;
+
+    const uint32_t y_begin = band_begin * args->band_rows;
+    const uint32_t y_end = band_end * args->band_rows < args->height ? band_end * args->band_rows : args->height;
+
+    own_arena arena = ownGetScratchArena();
+    const size_t arena_mark = ownArenaMark(arena);
+
+    // one extra column keeps the horizontal slide in bounds after the last pixel
+    uint32_t* columns = (uint32_t*)ownArenaCalloc(arena, width + 2 * args->radius + 1, sizeof(uint32_t));
+    // rows with gaps between pixels are gathered into two row buffers
+    const bool dense = ownIsRowDense(args->src_image) && ownIsRowDense(args->dst_image);
+    uint8_t* buffers = dense ? NULL : (uint8_t*)ownArenaAlloc(arena, 2 * (size_t)width);
+    if (!columns || (!dense && !buffers))
+    {
+        ownArenaReset(arena, arena_mark);
+        args->out_of_memory = 1;
+        return;
+    }
+    uint32_t* image_columns = columns + args->radius;
+
+    for (int32_t dy = -radius; dy <= radius; dy++)
+    {
+        const uint8_t* row = SourceRow(args, (int32_t)y_begin + dy, buffers);
+        for (uint32_t x = 0; x < width; x++)
+            image_columns[x] += row[x];
+    }
+
+    for (uint32_t y = y_begin; y < y_end; y++)
+    {
+        FillPadding(columns, width, args->radius);
+        ThresholdRow(args, columns, y, buffers);
+
+        if (y + 1 < y_end)
+        {
+            const uint8_t* add = SourceRow(args, (int32_t)y + radius + 1, buffers);
+            const uint8_t* sub = SourceRow(args, (int32_t)y - radius, buffers ? buffers + width : NULL);
+            for (uint32_t x = 0; x < width; x++)
+                image_columns[x] += (uint32_t)add[x] - sub[x];
+        }
+    }
+
+    ownArenaReset(arena, arena_mark);
+}
+
+vx_status ref_AdaptiveThreshold(const vx_image src_image, vx_image dst_image, const uint32_t block_size, const int32_t offset)
+{
+    if (block_size < 3 || block_size > ADAPTIVE_MAX_BLOCK_SIZE || block_size % 2 == 0)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (src_image->width != dst_image->width || src_image->height != dst_image->height)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (src_image->image_type != VX_DF_IMAGE_U8 || dst_image->image_type != VX_DF_IMAGE_U8)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (!ownCheckStrides(src_image) || !ownCheckStrides(dst_image))
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    const uint32_t width = src_image->width;
+    const uint32_t height = src_image->height;
+    if (width == 0 || height == 0)
+    {
+        return VX_SUCCESS;
+    }
+
+    AdaptiveArgs args;
+    args.src_image = src_image;
+    args.dst_image = dst_image;
+    args.width = width;
+    args.height = height;
+    args.radius = block_size / 2;
+    // any larger offset gives the same constant output
+    args.offset = offset > ADAPTIVE_MAX_OFFSET ? ADAPTIVE_MAX_OFFSET + 1 : offset < -ADAPTIVE_MAX_OFFSET ? -ADAPTIVE_MAX_OFFSET - 1 : offset;
+    args.band_rows = ADAPTIVE_BAND_WINDOWS * block_size;
+    args.out_of_memory = 0;
+
+    const uint32_t num_bands = (height + args.band_rows - 1) / args.band_rows;
+    const size_t band_bytes = (size_t)args.band_rows * width * 2;
+
+    ownParallelFor(num_bands, band_bytes, AdaptiveBands, &args);
+    return args.out_of_memory ? VX_ERROR_NO_MEMORY : VX_SUCCESS;
+}
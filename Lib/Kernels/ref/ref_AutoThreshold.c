@@ -0,0 +1,219 @@
+/*
+    File: ref_AutoThreshold.c
+    Содержит эталонную реализацию пороговой обработки с автоматическим
+    выбором порога.
+
+    Date: 18 Октября 2026
+*/
+
+#include "../ref.h"
+#include "../../Common/image.h"
+#include "../../Common/parallel.h"
+#include "../../Common/context.h"
+
+#include <string.h>
+
+#define HIST_SIZE 256
+
+// Consecutive pixels are counted into different copies of the histogram, so
+// equal neighbours do not serialise on one counter
+#define HIST_COPIES 4
+
+typedef struct
+{
+    vx_image image;
+    volatile int32_t out_of_memory;
+    volatile int32_t hist[HIST_SIZE];
+} HistogramArgs;
+
+static void CountPixels(uint32_t local[HIST_COPIES][HIST_SIZE], const uint8_t* src, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t quad;
+        memcpy(&quad, src + i, sizeof(quad));
+        local[0][quad & 0xFF]++;
+        local[1][(quad >> 8) & 0xFF]++;
+        local[2][(quad >> 16) & 0xFF]++;
+        local[3][quad >> 24]++;
+    }
+    for (; i < count; i++)
+        local[0][src[i]]++;
+}
+
+static void HistogramRows(void* data, uint32_t y_begin, uint32_t y_end)
+{
+    HistogramArgs* args = (HistogramArgs*)data;
+    const vx_image image = args->image;
+    const uint32_t width = image->width;
+
+    uint32_t local[HIST_COPIES][HIST_SIZE];
+    memset(local, 0, sizeof(local));
+
+    if (ownIsRowDense(image) && ownGetStrideY(image) == (int32_t)width)
+    {
+        CountPixels(local, ownGetPixelPtr(image, 0, y_begin), (size_t)(y_end - y_begin) * width);
+    }
+    else
+    {
+        own_arena arena = ownGetScratchArena();
+        const size_t arena_mark = ownArenaMark(arena);
+
+        uint8_t* buffer = ownIsRowDense(image) ? NULL : (uint8_t*)ownArenaAlloc(arena, width);
+        if (!ownIsRowDense(image) && !buffer)
+        {
+            args->out_of_memory = 1;
+            return;
+        }
+
+        for (uint32_t y = y_begin; y < y_end; y++)
+            CountPixels(local, (const uint8_t*)ownLoadRow(image, y, buffer), width);
+
+        ownArenaReset(arena, arena_mark);
+    }
+
+    for (uint32_t v = 0; v < HIST_SIZE; v++)
+    {
+        const uint32_t sum = local[0][v] + local[1][v] + local[2][v] + local[3][v];
+        if (sum)
+            ownAtomicAdd(&args->hist[v], (int32_t)sum);
+    }
+}
+
+static uint8_t OtsuThreshold(const uint32_t hist[HIST_SIZE])
+{
+    double total = 0.0;
+    double total_sum = 0.0;
+    for (uint32_t v = 0; v < HIST_SIZE; v++)
+    {
+        total += hist[v];
+        total_sum += (double)v * hist[v];
+    }
+
+    double weight0 = 0.0;
+    double sum0 = 0.0;
+    double best_variance = -1.0;
+    uint8_t best = 0;
+
+    // class 0 is [0, t], class 1 is (t, 255]
+    for (uint32_t t = 0; t < HIST_SIZE; t++)
+    {
+        weight0 += hist[t];
+        sum0 += (double)t * hist[t];
+
+        const double weight1 = total - weight0;
+        if (weight0 == 0.0 || weight1 == 0.0)
+            continue;
+
+        const double diff = sum0 / weight0 - (total_sum - sum0) / weight1;
+        const double variance = weight0 * weight1 * diff * diff;
+        if (variance > best_variance)
+        {
+            best_variance = variance;
+            best = (uint8_t)t;
+        }
+    }
+
+    return best;
+}
+
+static uint8_t TriangleThreshold(const uint32_t hist[HIST_SIZE])
+{
+    int32_t left = 0;
+    int32_t right = HIST_SIZE - 1;
+    int32_t peak = 0;
+
+    while (left < HIST_SIZE - 1 && hist[left] == 0)
+        left++;
+    while (right > 0 && hist[right] == 0)
+        right--;
+    for (int32_t v = 0; v < HIST_SIZE; v++)
+    {
+        if (hist[v] > hist[peak])
+            peak = v;
+    }
+
+    if (left > 0)
+        left--;
+    if (right < HIST_SIZE - 1)
+        right++;
+
+    // the line is drawn towards the longer tail; mirror the histogram so it is on the left
+    const bool flipped = peak - left < right - peak;
+    uint32_t h[HIST_SIZE];
+    for (int32_t v = 0; v < HIST_SIZE; v++)
+        h[v] = flipped ? hist[HIST_SIZE - 1 - v] : hist[v];
+    if (flipped)
+    {
+        left = HIST_SIZE - 1 - right;
+        peak = HIST_SIZE - 1 - peak;
+    }
+
+    int32_t threshold = left;
+    if (left != peak)
+    {
+        // distance to the line through (left, 0) and (peak, h[peak]), up to a constant factor
+        const double a = h[peak];
+        const double b = left - peak;
+        double best_distance = 0.0;
+        for (int32_t v = left + 1; v <= peak; v++)
+        {
+            const double distance = a * v + b * h[v];
+            if (distance > best_distance)
+            {
+                best_distance = distance;
+                threshold = v;
+            }
+        }
+    }
+    threshold--;
+
+    if (flipped)
+        threshold = HIST_SIZE - 1 - threshold;
+    if (threshold < 0)
+        threshold = 0;
+    if (threshold > UINT8_MAX)
+        threshold = UINT8_MAX;
+    return (uint8_t)threshold;
+}
+
+vx_status ref_AutoThreshold(const vx_image src_image, vx_image dst_image, const vx_enum method, vx_threshold thresh)
+{
+    if (method != VX_AUTO_THRESHOLD_OTSU_EXT && method != VX_AUTO_THRESHOLD_TRIANGLE_EXT)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (src_image->image_type != VX_DF_IMAGE_U8 || !ownCheckStrides(src_image))
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    // the chosen value is an 8-bit threshold; fail before the histogram pass
+    if (thresh->data_type != VX_TYPE_INVALID && thresh->data_type != VX_TYPE_UINT8)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    HistogramArgs args;
+    args.image = src_image;
+    args.out_of_memory = 0;
+    memset((void*)args.hist, 0, sizeof(args.hist));
+
+    ownParallelFor(src_image->height, src_image->width, HistogramRows, &args);
+    if (args.out_of_memory)
+    {
+        return VX_ERROR_NO_MEMORY;
+    }
+
+    uint32_t hist[HIST_SIZE];
+    for (uint32_t v = 0; v < HIST_SIZE; v++)
+        hist[v] = (uint32_t)args.hist[v];
+
+    thresh->threshold_type = VX_THRESHOLD_TYPE_BINARY;
+    thresh->value = method == VX_AUTO_THRESHOLD_OTSU_EXT ? OtsuThreshold(hist) : TriangleThreshold(hist);
+
+    // the second pass reads the frame again; it is still cache-resident for frames that fit the LLC
+    return ref_Threshold(src_image, dst_image, thresh);
+}
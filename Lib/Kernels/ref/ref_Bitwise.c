@@ -0,0 +1,130 @@
+/*
+    File: ref_Bitwise.c
+    Содержит эталонную реализацию побитовых операций над изображениями.
+
+    Date: 18 Октября 2026
+*/
+
+#include "../ref.h"
+#include "../../Common/image.h"
+
+#include <string.h>
+
+/*
+    The operations work on 64-bit words, so a packed binary image
+    (VX_DF_IMAGE_U1_EXT) is processed 64 pixels at a time.
+*/
+typedef enum
+{
+    BITWISE_AND,
+    BITWISE_OR,
+    BITWISE_XOR,
+    BITWISE_NOT
+} BitwiseOp;
+
+#define BITWISE_RUN(expr)                                                   \
+    for (; i + sizeof(uint64_t) <= count; i += sizeof(uint64_t))            \
+    {                                                                       \
+        uint64_t a;                                                         \
+        uint64_t b;                                                         \
+        memcpy(&a, src1 + i, sizeof(a));                                    \
+        memcpy(&b, src2 + i, sizeof(b));                                    \
+        const uint64_t r = (expr);                                          \
+        memcpy(dst + i, &r, sizeof(r));                                     \
+    }                                                                       \
+    for (; i < count; i++)                                                  \
+    {                                                                       \
+        const uint8_t a = src1[i];                                          \
+        const uint8_t b = src2[i];                                          \
+        dst[i] = (uint8_t)(expr);                                           \
+    }
+
+static void BitwiseRun(BitwiseOp op, const uint8_t* src1, const uint8_t* src2, uint8_t* dst, size_t count)
+{
+    size_t i = 0;
+
+    switch (op)
+    {
+    case BITWISE_AND:
+        BITWISE_RUN(a & b);
+        break;
+    case BITWISE_OR:
+        BITWISE_RUN(a | b);
+        break;
+    case BITWISE_XOR:
+        BITWISE_RUN(a ^ b);
+        break;
+    case BITWISE_NOT:
+        for (; i + sizeof(uint64_t) <= count; i += sizeof(uint64_t))
+        {
+            uint64_t a;
+            memcpy(&a, src1 + i, sizeof(a));
+            a = ~a;
+            memcpy(dst + i, &a, sizeof(a));
+        }
+        for (; i < count; i++)
+            dst[i] = (uint8_t)~src1[i];
+        break;
+    }
+}
+
+typedef struct
+{
+    BitwiseOp op;
+    uint32_t packed;
+} BitwiseArgs;
+
+static void BitwiseRow(const void* const* src, void* dst, uint32_t count, const void* data)
+{
+    const BitwiseArgs* args = (const BitwiseArgs*)data;
+    const size_t bytes = args->packed ? ((size_t)count + 7) / 8 : count;
+    const uint8_t* src2 = (const uint8_t*)src[args->op == BITWISE_NOT ? 0 : 1];
+
+    // for packed rows ownMapRows clears the padding bits that Not sets
+    BitwiseRun(args->op, (const uint8_t*)src[0], src2, (uint8_t*)dst, bytes);
+}
+
+static vx_status Bitwise(BitwiseOp op, const vx_image src1_image, const vx_image src2_image, vx_image dst_image)
+{
+    const vx_df_image format = dst_image->image_type;
+
+    if (format != VX_DF_IMAGE_U8 && format != VX_DF_IMAGE_U1_EXT)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (src1_image->image_type != format || src2_image->image_type != format)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    BitwiseArgs args;
+    args.op = op;
+    args.packed = format == VX_DF_IMAGE_U1_EXT;
+
+    vx_image src_images[2];
+    src_images[0] = src1_image;
+    src_images[1] = src2_image;
+
+    return ownMapRows(src_images, op == BITWISE_NOT ? 1 : 2, dst_image, BitwiseRow, &args);
+}
+
+vx_status ref_And(const vx_image src1_image, const vx_image src2_image, vx_image dst_image)
+{
+    return Bitwise(BITWISE_AND, src1_image, src2_image, dst_image);
+}
+
+vx_status ref_Or(const vx_image src1_image, const vx_image src2_image, vx_image dst_image)
+{
+    return Bitwise(BITWISE_OR, src1_image, src2_image, dst_image);
+}
+
+vx_status ref_Xor(const vx_image src1_image, const vx_image src2_image, vx_image dst_image)
+{
+    return Bitwise(BITWISE_XOR, src1_image, src2_image, dst_image);
+}
+
+vx_status ref_Not(const vx_image src_image, vx_image dst_image)
+{
+    return Bitwise(BITWISE_NOT, src_image, src_image, dst_image);
+}
@@ -0,0 +1,48 @@
+/*
+    File: ref_Box3x3.c
+    Содержит эталонную реализацию усредняющего фильтра 3x3.
+
+    Date: 18 Октября 2026
+*/
+
+#include "../ref.h"
+#include "../../Common/border.h"
+
+/*
+    Slides a three column window along the row, adding one column sum of
+    three source rows per pixel. The border is handled by ownMapWindow, so
+    the row function never looks past its window.
+*/
+static void BoxRow(const void* const* rows, void* dst, uint32_t count, const void* params)
+{
+    const uint8_t* above = (const uint8_t*)rows[0];
+    const uint8_t* row = (const uint8_t*)rows[1];
+    const uint8_t* below = (const uint8_t*)rows[2];
+    uint8_t* out = (uint8_t*)dst;
+    (void)params;
+
+    uint32_t left = (uint32_t)above[-1] + row[-1] + below[-1];
+    uint32_t center = (uint32_t)above[0] + row[0] + below[0];
+
+    for (uint32_t x = 0; x < count; x++)
+    {
+        const uint32_t right = (uint32_t)above[x + 1] + row[x + 1] + below[x + 1];
+        out[x] = (uint8_t)((left + center + right) / 9);
+        left = center;
+        center = right;
+    }
+}
+
+vx_status ref_Box3x3(const vx_image src_image, vx_image dst_image)
+{
+    if (src_image->image_type != VX_DF_IMAGE_U8 || dst_image->image_type != VX_DF_IMAGE_U8)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    vx_border_mode_t border;
+    border.mode = VX_BORDER_MODE_REPLICATE;
+    border.constant_value = 0;
+
+    return ownMapWindow(src_image, dst_image, 1, &border, BoxRow, NULL);
+}
@@ -4,6 +4,9 @@
 //@date 17 April 2016
 
 #include "../ref.h"
+#include "../../Common/image.h"
+#include "../../Common/context.h"
+#include "../../Common/border.h"
 #include <memory.h>
 
 // FUNCTION PROTOTYPES
@@ -17,23 +20,24 @@ void    SetPixel16S(vx_image image, uint32_t x, uint32_t y, int16_t value);
 uint32_t GetPixel32U(const vx_image image, uint32_t x, uint32_t y);
 void     SetPixel32U(vx_image image, uint32_t x, uint32_t y, uint32_t value);
 
-vx_image SobelFilter(const vx_image src);
+vx_image CreateScratchImages(own_arena arena, const uint32_t count, const uint32_t width, const uint32_t height, const enum vx_df_image_e format);
+void     InitColumnsView(vx_image view, const vx_image image, const uint32_t x_begin);
 
-vx_image CreatePixelCostImages(const vx_image left_img, const vx_image right_img, const int16_t max_disparity);
-vx_image CreateBlockCostImages(const vx_image pixel_cost_images, const uint32_t block_halfsize, const int16_t max_disparity);
-void     FillBlockCostImage(const vx_image block_cost_image, const vx_image pixel_cost_image, const int16_t disp, const uint32_t block_halfsize);
+vx_image SobelFilter(const vx_image src, const vx_border_mode_t *border, own_arena arena);
+void     SobelRow(const void* const* rows, void* dst, uint32_t count, const void* params);
 
-void FreeImage(vx_image image);
-void FreeImageArray(vx_image images, int32_t size);
+vx_image  CreatePixelCostImages(const vx_image left_img, const vx_image right_img, const int16_t max_disparity, own_arena arena);
+vx_image  CreateBlockCostImages(const vx_image pixel_cost_images, const uint32_t block_halfsize, const int16_t max_disparity, const vx_border_mode_t *border, own_arena arena);
+vx_status FillBlockCostImage(const vx_image block_cost_image, const vx_image pixel_cost_image, const int16_t disp, const uint32_t block_halfsize, const vx_border_mode_t *border);
+void      BlockCostRow(const void* const* rows, void* dst, uint32_t count, const void* params);
+uint32_t  BlockColumnSum(const void* const* rows, const uint32_t block_size, const int32_t x);
 
 int16_t Disparity(
 	const vx_coordinates2d_t pixel, const vx_image block_cost_images,
-	const int16_t max_disparity, const uint32_t block_halfsize, const uint32_t uniqueness_threshold);
+	const int16_t max_disparity, const uint32_t margin, const uint32_t uniqueness_threshold);
 
 int16_t SubPixelEstimation(const int16_t disparity, const int prev_cost, const int current_cost, const int next_cost);
 
-uint32_t SummOverBlock(const vx_image match_cost_image, const vx_rectangle_t *block);
-
 void    InterpolateBadPixels(vx_image image);
 int16_t Interpolate(vx_image image, vx_coordinates2d_t *pixel);
 ///////////////////////////////////////////////////////////////////////////////
@@ -51,32 +55,52 @@ vx_status ref_DisparityMap(
 		return VX_ERROR_INVALID_PARAMETERS;
 	}
 
+	if (!ownCheckStrides(left_img) || !ownCheckStrides(right_img) || !ownCheckStrides(disp_img))
+	{
+		return VX_ERROR_INVALID_PARAMETERS;
+	}
+
 	const uint32_t width = left_img->width;
 	const uint32_t height = left_img->height;
 	const uint32_t block_halfsize = block_size / 2;
 
-	vx_image left_filtered = SobelFilter(left_img);
-	vx_image right_filtered = SobelFilter(right_img);
+	// with a defined border every block is complete, so all rows and columns get a disparity
+	const vx_border_mode_t border = ownGetContext()->immediate_border;
+	const uint32_t margin = border.mode == VX_BORDER_MODE_UNDEFINED ? block_halfsize : 0;
 
-	struct _vx_image *pixel_cost_images = CreatePixelCostImages(left_filtered, right_filtered, max_disparity);
-	struct _vx_image *block_cost_images = CreateBlockCostImages(pixel_cost_images, block_halfsize, max_disparity);
+	// all intermediate images live in the thread's scratch arena until the end of the call
+	own_arena arena = ownGetScratchArena();
+	const size_t arena_mark = ownArenaMark(arena);
 
-	FreeImageArray(pixel_cost_images, (size_t)(max_disparity + 1));
-	FreeImage(left_filtered);
-	FreeImage(right_filtered);
+	vx_image left_filtered = SobelFilter(left_img, &border, arena);
+	vx_image right_filtered = SobelFilter(right_img, &border, arena);
+
+	struct _vx_image *pixel_cost_images = left_filtered && right_filtered ?
+		CreatePixelCostImages(left_filtered, right_filtered, max_disparity, arena) : NULL;
+	struct _vx_image *block_cost_images = pixel_cost_images ?
+		CreateBlockCostImages(pixel_cost_images, block_halfsize, max_disparity, &border, arena) : NULL;
+
+	if (!block_cost_images)
+	{
+		ownArenaReset(arena, arena_mark);
+		return VX_ERROR_NO_MEMORY;
+	}
 
 	vx_coordinates2d_t pixel;
 
-	for (pixel.y = block_halfsize; pixel.y < height - block_halfsize; pixel.y++)
+	const uint32_t y_end = height > margin ? height - margin : 0;
+	const uint32_t x_end = width > margin ? width - margin : 0;
+
+	for (pixel.y = margin; pixel.y < y_end; pixel.y++)
 	{
-		for (pixel.x = (uint32_t)(max_disparity); pixel.x < width - block_halfsize; pixel.x++)
+		for (pixel.x = (uint32_t)(max_disparity); pixel.x < x_end; pixel.x++)
 		{
-			int16_t disparity = Disparity(pixel, block_cost_images, max_disparity, block_halfsize, uniqueness_threshold);
+			int16_t disparity = Disparity(pixel, block_cost_images, max_disparity, margin, uniqueness_threshold);
 			SetPixel16S(disp_img, pixel.x, pixel.y, disparity);
 		}
 	}
 
-	FreeImageArray(block_cost_images, (size_t)(max_disparity + 1));
+	ownArenaReset(arena, arena_mark);
 
 	return VX_SUCCESS;
 }
@@ -96,97 +120,104 @@ bool CheckImageFormats(const vx_image left_img, const vx_image right_img, const
 
 uint8_t GetPixel8U(const vx_image image, uint32_t x, uint32_t y)
 {
-	uint8_t *pixels = (uint8_t*)(image->data);
-	return pixels[y * image->width + x];
+	return *(uint8_t*)ownGetPixelPtr(image, x, y);
 }
 
 void SetPixel8U(vx_image image, uint32_t x, uint32_t y, uint8_t value)
 {
-	uint8_t *pixels = (uint8_t*)(image->data);
-	pixels[y * image->width + x] = value;
+	*(uint8_t*)ownGetPixelPtr(image, x, y) = value;
 }
 
 int16_t GetPixel16S(const vx_image image, uint32_t x, uint32_t y)
 {
-	int16_t *pixels = (int16_t*)(image->data);
-	return pixels[y * image->width + x];
+	return *(int16_t*)ownGetPixelPtr(image, x, y);
 }
 
 void SetPixel16S(vx_image image, uint32_t x, uint32_t y, int16_t value)
 {
-	int16_t *pixels = (int16_t*)(image->data);
-	pixels[y * image->width + x] = value;
+	*(int16_t*)ownGetPixelPtr(image, x, y) = value;
 }
 
 uint32_t GetPixel32U(const vx_image image, uint32_t x, uint32_t y)
 {
-	uint32_t *pixels = (uint32_t*)(image->data);
-	return pixels[y * image->width + x];
+	return *(uint32_t*)ownGetPixelPtr(image, x, y);
 }
 
 void SetPixel32U(vx_image image, uint32_t x, uint32_t y, uint32_t value)
 {
-	uint32_t *pixels = (uint32_t*)(image->data);
-	pixels[y * image->width + x] = value;
+	*(uint32_t*)ownGetPixelPtr(image, x, y) = value;
 }
 
-vx_image SobelFilter(const vx_image src)
+vx_image CreateScratchImages(own_arena arena, const uint32_t count, const uint32_t width, const uint32_t height, const enum vx_df_image_e format)
 {
-	const uint32_t width = src->width;
-	const uint32_t height = src->height;
-
-	vx_image dest = (vx_image)malloc(sizeof(struct _vx_image));
-	dest->data = calloc(width * height, sizeof(int16_t));
-	dest->width = width;
-	dest->height = height;
-	dest->image_type = VX_DF_IMAGE_S16;
-	dest->color_space = VX_COLOR_SPACE_DEFAULT;
-
-	const int kernel[] = {
-		-1, 0, 1,
-		-2, 0, 2,
-		-1, 0, 1
-	};
-
-	const uint32_t kernel_halfsize = 1;
-	const uint32_t kernel_size = 3;
+	vx_image images = (vx_image)ownArenaCalloc(arena, count, sizeof(struct _vx_image));
+	if (!images)
+		return NULL;
 
-	for (uint32_t y = kernel_halfsize; y < height - kernel_halfsize; y++)
+	for (uint32_t i = 0; i < count; i++)
 	{
-		for (uint32_t x = kernel_halfsize; x < width - kernel_halfsize; x++)
-		{
-			int sum = 0;
-			for (uint32_t i = 0; i < kernel_size; i++)
-			{
-				for (uint32_t j = 0; j < kernel_size; j++)
-				{
-					uint8_t pixel = GetPixel8U(src, x - kernel_halfsize + j, y - kernel_halfsize + i);
-					sum += kernel[i * kernel_size + j] * pixel;
-				}
-			}
-			SetPixel16S(dest, x, y, (int16_t)(sum));
-		}
+		images[i].data = ownArenaCalloc(arena, (size_t)width * height, ownGetPixelSize(format));
+		if (!images[i].data)
+			return NULL;
+		images[i].width = width;
+		images[i].height = height;
+		images[i].image_type = format;
+		images[i].color_space = VX_COLOR_SPACE_DEFAULT;
+		images[i].num_planes = 1;
+		images[i].import_type = VX_IMPORT_TYPE_NONE;
 	}
 
+	return images;
+}
+
+void InitColumnsView(vx_image view, const vx_image image, const uint32_t x_begin)
+{
+	*view = *image;
+	view->data = ownGetPixelPtr(image, x_begin, 0);
+	view->width = image->width - x_begin;
+	view->stride_x = ownGetStrideX(image);
+	view->stride_y = ownGetStrideY(image);
+	view->memory = NULL;
+}
+
+vx_image SobelFilter(const vx_image src, const vx_border_mode_t *border, own_arena arena)
+{
+	vx_image dest = CreateScratchImages(arena, 1, src->width, src->height, VX_DF_IMAGE_S16);
+	if (!dest)
+		return NULL;
+
+	// with VX_BORDER_MODE_UNDEFINED the border pixels stay zero
+	if (ownMapWindow(src, dest, 1, border, SobelRow, NULL) != VX_SUCCESS)
+		return NULL;
+
 	return dest;
 }
 
-vx_image CreatePixelCostImages(const vx_image left_img, const vx_image right_img, const int16_t max_disparity)
+// horizontal Sobel kernel: (-1 0 1; -2 0 2; -1 0 1)
+void SobelRow(const void* const* rows, void* dst, uint32_t count, const void* params)
+{
+	const uint8_t *above = (const uint8_t*)rows[0] - 1;
+	const uint8_t *row = (const uint8_t*)rows[1] - 1;
+	const uint8_t *below = (const uint8_t*)rows[2] - 1;
+	int16_t *out = (int16_t*)dst;
+	(void)params;
+
+	for (uint32_t x = 0; x < count; x++)
+	{
+		int sum = (above[x + 2] - above[x]) + 2 * (row[x + 2] - row[x]) + (below[x + 2] - below[x]);
+		out[x] = (int16_t)(sum);
+	}
+}
+
+vx_image CreatePixelCostImages(const vx_image left_img, const vx_image right_img, const int16_t max_disparity, own_arena arena)
 {
 	const uint32_t width = left_img->width;
 	const uint32_t height = right_img->height;
 	const uint32_t num_disparities = max_disparity + 1;
 
-	vx_image match_cost_images = (vx_image)calloc(num_disparities, sizeof(struct _vx_image));
-
-	for (int16_t i = 0; i <= max_disparity; i++)
-	{
-		match_cost_images[i].data = calloc(width*height, sizeof(int16_t));
-		match_cost_images[i].width = width;
-		match_cost_images[i].height = height;
-		match_cost_images[i].image_type = VX_DF_IMAGE_S16;
-		match_cost_images[i].color_space = VX_COLOR_SPACE_DEFAULT;
-	}
+	vx_image match_cost_images = CreateScratchImages(arena, num_disparities, width, height, VX_DF_IMAGE_S16);
+	if (!match_cost_images)
+		return NULL;
 
 	for (uint32_t y = 0; y < height; y++)
 	{
@@ -209,140 +240,97 @@ vx_image CreatePixelCostImages(const vx_image left_img, const vx_image right_img
 	return match_cost_images;
 }
 
-vx_image CreateBlockCostImages(const vx_image pixel_cost_images, const uint32_t block_halfsize, const int16_t max_disparity)
+vx_image CreateBlockCostImages(const vx_image pixel_cost_images, const uint32_t block_halfsize, const int16_t max_disparity, const vx_border_mode_t *border, own_arena arena)
 {
 	const uint32_t width = pixel_cost_images[0].width;
 	const uint32_t height = pixel_cost_images[0].height;
 	const uint32_t num_disparities = max_disparity + 1;
 
-	vx_image block_cost_images = (vx_image)calloc(num_disparities, sizeof(struct _vx_image));
-
-	for (int16_t i = 0; i <= max_disparity; i++)
-	{
-		block_cost_images[i].data = calloc(width*height, sizeof(uint32_t));
-		block_cost_images[i].width = width;
-		block_cost_images[i].height = height;
-		block_cost_images[i].image_type = VX_DF_IMAGE_U32;
-		block_cost_images[i].color_space = VX_COLOR_SPACE_DEFAULT;
-	}
+	vx_image block_cost_images = CreateScratchImages(arena, num_disparities, width, height, VX_DF_IMAGE_U32);
+	if (!block_cost_images)
+		return NULL;
 
-	for (int16_t disp = 0; disp <= max_disparity; disp++)
+	for (int16_t disp = 0; disp <= max_disparity && (uint32_t)disp < width; disp++)
 	{
-		FillBlockCostImage(&block_cost_images[disp], &pixel_cost_images[disp], disp, block_halfsize);
+		if (FillBlockCostImage(&block_cost_images[disp], &pixel_cost_images[disp], disp, block_halfsize, border) != VX_SUCCESS)
+			return NULL;
 	}
 
 	return block_cost_images;
 }
 
-void FillBlockCostImage(const vx_image block_cost_image, const vx_image pixel_cost_image, const int16_t disp, const uint32_t block_halfsize)
+// Pixel costs of disparity disp exist for x >= disp only, so the blocks are
+// summed over that part of the image and the border mode applies at its edges.
+vx_status FillBlockCostImage(const vx_image block_cost_image, const vx_image pixel_cost_image, const int16_t disp, const uint32_t block_halfsize, const vx_border_mode_t *border)
 {
-	const uint32_t width = block_cost_image->width;
-	const uint32_t height = block_cost_image->height;
-	uint32_t x = disp + block_halfsize;
-	uint32_t y = block_halfsize;
-
-	// first pixel
-	vx_rectangle_t block;
-	block.start_x = x - block_halfsize;
-	block.start_y = y - block_halfsize;
-	block.end_x = x + block_halfsize;
-	block.end_y = y + block_halfsize;
-
-	uint32_t cost = SummOverBlock(pixel_cost_image, &block);
-	SetPixel32U(block_cost_image, x, y, cost);
-
-	uint32_t take;
-	uint32_t add;
-
-	// first row
-	for (x++; x < width - block_halfsize; x++)
-	{
-		block.start_x = x - 1 - block_halfsize;
-		block.end_x = x - 1 - block_halfsize;
-		block.start_y = y - block_halfsize;
-		block.end_y = y + block_halfsize;
-
-		take = SummOverBlock(pixel_cost_image, &block);
+	struct _vx_image block_cost_view;
+	struct _vx_image pixel_cost_view;
+	InitColumnsView(&block_cost_view, block_cost_image, (uint32_t)disp);
+	InitColumnsView(&pixel_cost_view, pixel_cost_image, (uint32_t)disp);
 
-		block.start_x = x + block_halfsize;
-		block.end_x = x + block_halfsize;
+	return ownMapWindow(&pixel_cost_view, &block_cost_view, block_halfsize, border, BlockCostRow, &block_halfsize);
+}
 
-		add = SummOverBlock(pixel_cost_image, &block);
+// Sums the columns of the block once and slides the block along them.
+void BlockCostRow(const void* const* rows, void* dst, uint32_t count, const void* params)
+{
+	const uint32_t block_halfsize = *(const uint32_t*)params;
+	const uint32_t block_size = 2 * block_halfsize + 1;
+	const size_t num_columns = (size_t)count + 2 * block_halfsize;
+	uint32_t *out = (uint32_t*)dst;
 
-		cost = cost - take + add;
-		SetPixel32U(block_cost_image, x, y, cost);
-	}
+	own_arena arena = ownGetScratchArena();
+	const size_t arena_mark = ownArenaMark(arena);
+	uint32_t *columns = (uint32_t*)ownArenaAlloc(arena, num_columns * sizeof(uint32_t));
 
-	for (y++; y < height - block_halfsize; y++)
+	if (!columns)
 	{
-		// first pixel in row
-		x = block_halfsize + disp;
-		cost = GetPixel32U(block_cost_image, x, y - 1);
-
-		block.start_x = x - block_halfsize;
-		block.end_x = x + block_halfsize;
-		block.start_y = y - 1 - block_halfsize;
-		block.end_y = y - 1 - block_halfsize;
-
-		take = SummOverBlock(pixel_cost_image, &block);
-
-		block.start_y = y + block_halfsize;
-		block.end_y = y + block_halfsize;
-
-		add = SummOverBlock(pixel_cost_image, &block);
-
-		cost = cost - take + add;
-		SetPixel32U(block_cost_image, x, y, cost);
-
-		// other pixels in row
-		for (x++; x < width - block_halfsize; x++)
+		// no scratch memory: every block is summed directly
+		for (uint32_t x = 0; x < count; x++)
 		{
-			uint32_t take_take = GetPixel16S(pixel_cost_image, x - 1 - block_halfsize, y - 1 - block_halfsize);
-			uint32_t take_add = GetPixel16S(pixel_cost_image, x + block_halfsize, y - 1 - block_halfsize);
-			take = take - take_take + take_add;
-
-			uint32_t add_take = GetPixel16S(pixel_cost_image, x - 1 - block_halfsize, y + block_halfsize);
-			uint32_t add_add = GetPixel16S(pixel_cost_image, x + block_halfsize, y + block_halfsize);
-			add = add - add_take + add_add;
-
-			cost = GetPixel32U(block_cost_image, x, y - 1);
-			cost = cost - take + add;
-			SetPixel32U(block_cost_image, x, y, cost);
+			uint32_t cost = 0;
+			for (uint32_t j = 0; j < block_size; j++)
+				cost += BlockColumnSum(rows, block_size, (int32_t)(x + j) - (int32_t)block_halfsize);
+			out[x] = cost;
 		}
+		ownArenaReset(arena, arena_mark);
+		return;
 	}
-}
 
-void FreeImage(vx_image image)
-{
-	if (image)
+	for (size_t i = 0; i < num_columns; i++)
+		columns[i] = BlockColumnSum(rows, block_size, (int32_t)i - (int32_t)block_halfsize);
+
+	uint32_t cost = 0;
+	for (uint32_t j = 0; j + 1 < block_size; j++)
+		cost += columns[j];
+
+	for (uint32_t x = 0; x < count; x++)
 	{
-		if (image->data)
-			free(image->data);
-		free(image);
+		cost += columns[x + block_size - 1];
+		out[x] = cost;
+		cost -= columns[x];
 	}
+
+	ownArenaReset(arena, arena_mark);
 }
 
-void FreeImageArray(vx_image images, int32_t size)
+uint32_t BlockColumnSum(const void* const* rows, const uint32_t block_size, const int32_t x)
 {
-	if (images)
-	{
-		for (int32_t i = 0; i < size; i++)
-		{
-			if (images[i].data)
-				free(images[i].data);
-		}
-		free(images);
-	}
+	uint32_t sum = 0;
+	for (uint32_t i = 0; i < block_size; i++)
+		sum += (uint32_t)((const int16_t*)rows[i])[x];
+	return sum;
 }
 
 int16_t Disparity(
 	const vx_coordinates2d_t pixel, const vx_image block_cost_images,
-	const int16_t max_disparity, const uint32_t block_halfsize, const uint32_t uniqueness_threshold)
+	const int16_t max_disparity, const uint32_t margin, const uint32_t uniqueness_threshold)
 {
 	uint32_t min_diff = UINT32_MAX;
 	int16_t  best_disp = 0;
 
-	const int16_t limit_disp = pixel.x >= block_halfsize + max_disparity ? max_disparity : (int16_t)(pixel.x - block_halfsize);
+	// block costs of disparity disp start at column disp + margin
+	const int16_t limit_disp = pixel.x >= margin + max_disparity ? max_disparity : (int16_t)(pixel.x - margin);
 
 	for (int16_t disp = 0; disp <= limit_disp; disp++)
 	{
@@ -387,21 +375,6 @@ int16_t SubPixelEstimation(const int16_t disparity, const int prev_cost, const i
 		return disparity;
 }
 
-uint32_t SummOverBlock(const vx_image match_cost_image, const vx_rectangle_t *block)
-{
-	uint32_t sum = 0;
-
-	for (uint32_t y = block->start_y; y <= block->end_y; y++)
-	{
-		for (uint32_t x = block->start_x; x <= block->end_x; x++)
-		{
-			sum += (uint32_t)GetPixel16S(match_cost_image, x, y);
-		}
-	}
-
-	return sum;
-}
-
 void InterpolateBadPixels(vx_image image)
 {
 	vx_coordinates2d_t pixel;
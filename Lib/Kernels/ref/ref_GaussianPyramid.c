@@ -0,0 +1,171 @@
+/*
+    File: ref_GaussianPyramid.c
+    Содержит эталонную реализацию построения гауссовой пирамиды.
+
+    Date: 18 Октября 2026
+*/
+
+#include "../ref.h"
+#include "../../Common/image.h"
+#include "../../Common/border.h"
+#include "../../Common/context.h"
+
+#include <string.h>
+
+/*
+    All levels are built in one pass over the source: a row of level k is
+    filtered and downsampled as soon as the rows of level k - 1 under its
+    5x5 window exist, so the rows a level reads are still in cache when it
+    reads them. Each row is filtered vertically into column sums padded by
+    the border mode, then horizontally at the sampled columns only.
+*/
+typedef struct
+{
+    vx_image levels;
+    uint32_t num_levels;
+    float scale;
+    vx_border_mode_t border;
+    // rows of each level written so far
+    uint32_t* produced;
+    // source column of every pixel of each level (index 0 unused)
+    uint32_t** x_maps;
+    // vertical sums of a source row with two padding columns on each side
+    uint16_t* columns;
+    uint8_t* constant_row;
+} PyramidState;
+
+// Level pixel y is sampled from pixel y / scale of the level above
+static uint32_t SourceIndex(uint32_t y, float scale, uint32_t size)
+{
+    const uint32_t index = (uint32_t)((double)y / scale);
+    return index < size ? index : size - 1;
+}
+
+static bool IsRowReady(const PyramidState* state, uint32_t level, uint32_t y)
+{
+    const vx_image src = &state->levels[level - 1];
+    const uint32_t last = SourceIndex(y, state->scale, src->height) + 2;
+    return state->produced[level - 1] > (last < src->height ? last : src->height - 1);
+}
+
+static void ProduceRow(const PyramidState* state, uint32_t level, uint32_t y)
+{
+    const vx_image src = &state->levels[level - 1];
+    const vx_image dst = &state->levels[level];
+    const uint32_t width = src->width;
+    const int32_t sy = (int32_t)SourceIndex(y, state->scale, src->height);
+    uint16_t* columns = state->columns;
+
+    // level rows are dense, so no row buffers are needed
+    const uint8_t* rows[5];
+    for (int32_t i = 0; i < 5; i++)
+        rows[i] = (const uint8_t*)ownGetBorderRow(src, sy - 2 + i, &state->border, state->constant_row, NULL);
+
+    for (uint32_t x = 0; x < width; x++)
+    {
+        columns[x + 2] = (uint16_t)(rows[0][x] + 4 * (rows[1][x] + rows[3][x]) + 6 * rows[2][x] + rows[4][x]);
+    }
+
+    if (state->border.mode == VX_BORDER_MODE_CONSTANT)
+    {
+        const uint16_t value = (uint16_t)(16 * (uint8_t)state->border.constant_value);
+        columns[0] = columns[1] = columns[width + 2] = columns[width + 3] = value;
+    }
+    else
+    {
+        columns[0] = columns[1] = columns[2];
+        columns[width + 2] = columns[width + 3] = columns[width + 1];
+    }
+
+    const uint32_t* x_map = state->x_maps[level];
+    uint8_t* out = (uint8_t*)ownGetPixelPtr(dst, 0, y);
+
+    for (uint32_t x = 0; x < dst->width; x++)
+    {
+        const uint16_t* c = columns + x_map[x];
+        out[x] = (uint8_t)((c[0] + 4 * (c[1] + c[3]) + 6 * c[2] + c[4] + 128) >> 8);
+    }
+}
+
+vx_status ref_GaussianPyramid(const vx_image src_image, vx_pyramid dst_pyramid)
+{
+    if (src_image->image_type != VX_DF_IMAGE_U8 || dst_pyramid->image_type != VX_DF_IMAGE_U8)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (src_image->width != dst_pyramid->width || src_image->height != dst_pyramid->height)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    if (!ownCheckStrides(src_image))
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    PyramidState state;
+    state.levels = dst_pyramid->levels;
+    state.num_levels = (uint32_t)dst_pyramid->numLevels;
+    state.scale = dst_pyramid->scale;
+    // an undefined border may hold any values; replicating keeps them in range
+    state.border = ownGetContext()->immediate_border;
+    if (state.border.mode == VX_BORDER_MODE_UNDEFINED)
+        state.border.mode = VX_BORDER_MODE_REPLICATE;
+
+    const uint32_t width = src_image->width;
+
+    own_arena arena = ownGetScratchArena();
+    const size_t arena_mark = ownArenaMark(arena);
+
+    state.produced = (uint32_t*)ownArenaCalloc(arena, state.num_levels, sizeof(uint32_t));
+    state.x_maps = (uint32_t**)ownArenaCalloc(arena, state.num_levels, sizeof(uint32_t*));
+    state.columns = (uint16_t*)ownArenaAlloc(arena, ((size_t)width + 4) * sizeof(uint16_t));
+    state.constant_row = (uint8_t*)ownArenaAlloc(arena, width);
+    bool failed = !state.produced || !state.x_maps || !state.columns || !state.constant_row;
+
+    for (uint32_t k = 1; k < state.num_levels && !failed; k++)
+    {
+        const vx_image level = &state.levels[k];
+        state.x_maps[k] = (uint32_t*)ownArenaAlloc(arena, (size_t)level->width * sizeof(uint32_t));
+        if (!state.x_maps[k])
+        {
+            failed = true;
+            break;
+        }
+        // the index of the first of five padded column sums around the source column
+        for (uint32_t x = 0; x < level->width; x++)
+            state.x_maps[k][x] = SourceIndex(x, state.scale, state.levels[k - 1].width);
+    }
+
+    if (failed)
+    {
+        ownArenaReset(arena, arena_mark);
+        return VX_ERROR_NO_MEMORY;
+    }
+
+    memset(state.constant_row, (uint8_t)state.border.constant_value, width);
+
+    const vx_image base = &state.levels[0];
+    for (uint32_t y = 0; y < base->height; y++)
+    {
+        uint8_t* row = (uint8_t*)ownGetPixelPtr(base, 0, y);
+        const void* src_row = ownLoadRow(src_image, y, row);
+        if (src_row != row)
+            memcpy(row, src_row, width);
+        state.produced[0] = y + 1;
+
+        // each new row may complete windows of every smaller level in turn
+        for (uint32_t k = 1; k < state.num_levels; k++)
+        {
+            while (state.produced[k] < state.levels[k].height && IsRowReady(&state, k, state.produced[k]))
+            {
+                ProduceRow(&state, k, state.produced[k]);
+                state.produced[k]++;
+            }
+        }
+    }
+
+    ownArenaReset(arena, arena_mark);
+    return VX_SUCCESS;
+}
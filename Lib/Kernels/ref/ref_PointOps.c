@@ -0,0 +1,69 @@
+/*
+    File: ref_PointOps.c
+    Содержит эталонную реализацию цепочки поэлементных операций.
+
+    Date: 18 Октября 2026
+*/
+
+#include "../ref.h"
+#include "../../Common/lut.h"
+
+#include <string.h>
+
+/*
+    Every operation of the chain maps 8 bits to 8 bits, so the chain is
+    folded into one table and the image is read and written only once.
+*/
+static vx_status CompileOp(const vx_point_op_ext* op, uint8_t table[OWN_LUT8_SIZE])
+{
+    switch (op->type)
+    {
+    case VX_POINT_OP_THRESHOLD_EXT:
+        if (!op->threshold)
+            return VX_ERROR_INVALID_PARAMETERS;
+        return ownLutFromThreshold(table, op->threshold);
+
+    case VX_POINT_OP_TABLE_LOOKUP_EXT:
+        if (!op->lut || !op->lut->data || op->lut->size != OWN_LUT8_SIZE)
+            return VX_ERROR_INVALID_PARAMETERS;
+        memcpy(table, op->lut->data, OWN_LUT8_SIZE);
+        return VX_SUCCESS;
+
+    case VX_POINT_OP_CONTRAST_EXT:
+        ownLutFromContrast(table, op->gain, op->bias);
+        return VX_SUCCESS;
+
+    case VX_POINT_OP_GAMMA_EXT:
+        if (!(op->gamma > 0.0f))
+            return VX_ERROR_INVALID_PARAMETERS;
+        ownLutFromGamma(table, op->gamma);
+        return VX_SUCCESS;
+
+    default:
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+}
+
+vx_status ref_PointOps(const vx_image src_image, vx_image dst_image, const vx_point_op_ext* ops, uint32_t num_ops)
+{
+    if (num_ops > 0 && !ops)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    uint8_t table[OWN_LUT8_SIZE];
+    uint8_t op_table[OWN_LUT8_SIZE];
+
+    ownLutIdentity(table);
+
+    for (uint32_t i = 0; i < num_ops; i++)
+    {
+        const vx_status status = CompileOp(&ops[i], op_table);
+        if (status != VX_SUCCESS)
+            return status;
+
+        ownLutAppend(table, op_table);
+    }
+
+    return ownApplyLutImage(src_image, dst_image, table);
+}
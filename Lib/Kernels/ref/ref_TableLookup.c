@@ -0,0 +1,19 @@
+/*
+    File: ref_TableLookup.c
+    Содержит эталонную реализацию преобразования изображения по таблице.
+
+    Date: 18 Октября 2026
+*/
+
+#include "../ref.h"
+#include "../../Common/lut.h"
+
+vx_status ref_TableLookup(const vx_image src_image, vx_image dst_image, const vx_lut lut)
+{
+    if (!lut->data || lut->size != OWN_LUT8_SIZE)
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    return ownApplyLutImage(src_image, dst_image, lut->data);
+}
@@ -8,6 +8,345 @@
 */
 
 #include "../ref.h"
+#include "../../Common/cpu.h"
+#include "../../Common/image.h"
+
+#include <string.h>
+
+/*
+    Both threshold types are reduced to the inclusive range [lower, upper]
+    clipped to the range of the input type: binary is (value, max], range is
+    [lower_threshold, upper_threshold]. Pixels inside get true_value, the
+    rest get false_value. The row function is selected once per call by the
+    input format and the CPU features.
+*/
+typedef struct
+{
+    int32_t lower;
+    int32_t upper;
+    uint32_t true_value;
+    uint32_t false_value;
+} ThresholdParams;
+
+typedef void (*ThresholdRowFunc)(const void* src, uint8_t* dst, uint32_t count, const ThresholdParams* params);
+
+#define THRESHOLD_ROW_SCALAR(name, type)                                                        \
+static void name(const void* src_row, uint8_t* dst, uint32_t count, const ThresholdParams* params) \
+{                                                                                               \
+    const type* src = (const type*)src_row;                                                     \
+    const type lower = (type)params->lower;                                                     \
+    const type upper = (type)params->upper;                                                     \
+    const uint8_t true_value = (uint8_t)params->true_value;                                     \
+    const uint8_t false_value = (uint8_t)params->false_value;                                   \
+                                                                                                \
+    for (uint32_t i = 0; i < count; i++)                                                        \
+        dst[i] = (src[i] >= lower && src[i] <= upper) ? true_value : false_value;               \
+}
+
+THRESHOLD_ROW_SCALAR(ThresholdRowScalarU8, uint8_t)
+THRESHOLD_ROW_SCALAR(ThresholdRowScalarU16, uint16_t)
+THRESHOLD_ROW_SCALAR(ThresholdRowScalarS16, int16_t)
+
+#ifdef VX_ARCH_X86
+
+/*
+    The SIMD versions build a byte mask per pixel and blend the output values
+    as false ^ (inside & (true ^ false)). 16-bit masks are narrowed to bytes
+    with a signed pack, which keeps 0 and -1 as they are.
+*/
+
+// unsigned pixel is inside [lower, upper] when both saturated differences are zero
+#define INSIDE_U8_SSE2(v) \
+    _mm_cmpeq_epi8(_mm_or_si128(_mm_subs_epu8(v, vupper), _mm_subs_epu8(vlower, v)), zero)
+#define INSIDE_U16_SSE2(v) \
+    _mm_cmpeq_epi16(_mm_or_si128(_mm_subs_epu16(v, vupper), _mm_subs_epu16(vlower, v)), zero)
+#define INSIDE_S16_SSE2(v) \
+    _mm_andnot_si128(_mm_or_si128(_mm_cmpgt_epi16(v, vupper), _mm_cmpgt_epi16(vlower, v)), ones)
+#define BLEND_SSE2(mask) \
+    _mm_xor_si128(vfalse, _mm_and_si128(mask, vdiff))
+
+#define INSIDE_U8_AVX2(v) \
+    _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_subs_epu8(v, vupper), _mm256_subs_epu8(vlower, v)), zero)
+#define INSIDE_U16_AVX2(v) \
+    _mm256_cmpeq_epi16(_mm256_or_si256(_mm256_subs_epu16(v, vupper), _mm256_subs_epu16(vlower, v)), zero)
+#define INSIDE_S16_AVX2(v) \
+    _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpgt_epi16(v, vupper), _mm256_cmpgt_epi16(vlower, v)), ones)
+#define BLEND_AVX2(mask) \
+    _mm256_xor_si256(vfalse, _mm256_and_si256(mask, vdiff))
+
+// vpacksswb packs within 128-bit lanes, the permutation restores pixel order
+#define PACK16_AVX2(a, b) \
+    _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0xD8)
+
+#define BLEND_VALUES_SSE2                                                   \
+    const __m128i vfalse = _mm_set1_epi8((char)params->false_value);       \
+    const __m128i vdiff = _mm_set1_epi8((char)(params->true_value ^ params->false_value))
+
+#define BLEND_VALUES_AVX2                                                   \
+    const __m256i vfalse = _mm256_set1_epi8((char)params->false_value);    \
+    const __m256i vdiff = _mm256_set1_epi8((char)(params->true_value ^ params->false_value))
+
+static void ThresholdRowSSE2U8(const void* src_row, uint8_t* dst, uint32_t count, const ThresholdParams* params)
+{
+    const uint8_t* src = (const uint8_t*)src_row;
+    const __m128i vlower = _mm_set1_epi8((char)params->lower);
+    const __m128i vupper = _mm_set1_epi8((char)params->upper);
+    const __m128i zero = _mm_setzero_si128();
+    BLEND_VALUES_SSE2;
+
+    uint32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(src + i + 16));
+        _mm_storeu_si128((__m128i*)(dst + i), BLEND_SSE2(INSIDE_U8_SSE2(a)));
+        _mm_storeu_si128((__m128i*)(dst + i + 16), BLEND_SSE2(INSIDE_U8_SSE2(b)));
+    }
+    if (i + 16 <= count)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), BLEND_SSE2(INSIDE_U8_SSE2(a)));
+        i += 16;
+    }
+
+    ThresholdRowScalarU8(src + i, dst + i, count - i, params);
+}
+
+static void ThresholdRowSSE2U16(const void* src_row, uint8_t* dst, uint32_t count, const ThresholdParams* params)
+{
+    const uint16_t* src = (const uint16_t*)src_row;
+    const __m128i vlower = _mm_set1_epi16((short)params->lower);
+    const __m128i vupper = _mm_set1_epi16((short)params->upper);
+    const __m128i zero = _mm_setzero_si128();
+    BLEND_VALUES_SSE2;
+
+    uint32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(src + i + 8));
+        const __m128i mask = _mm_packs_epi16(INSIDE_U16_SSE2(a), INSIDE_U16_SSE2(b));
+        _mm_storeu_si128((__m128i*)(dst + i), BLEND_SSE2(mask));
+    }
+
+    ThresholdRowScalarU16(src + i, dst + i, count - i, params);
+}
+
+static void ThresholdRowSSE2S16(const void* src_row, uint8_t* dst, uint32_t count, const ThresholdParams* params)
+{
+    const int16_t* src = (const int16_t*)src_row;
+    const __m128i vlower = _mm_set1_epi16((short)params->lower);
+    const __m128i vupper = _mm_set1_epi16((short)params->upper);
+    const __m128i ones = _mm_set1_epi8(-1);
+    BLEND_VALUES_SSE2;
+
+    uint32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(src + i + 8));
+        const __m128i mask = _mm_packs_epi16(INSIDE_S16_SSE2(a), INSIDE_S16_SSE2(b));
+        _mm_storeu_si128((__m128i*)(dst + i), BLEND_SSE2(mask));
+    }
+
+    ThresholdRowScalarS16(src + i, dst + i, count - i, params);
+}
+
+VX_TARGET_AVX2
+static void ThresholdRowAVX2U8(const void* src_row, uint8_t* dst, uint32_t count, const ThresholdParams* params)
+{
+    const uint8_t* src = (const uint8_t*)src_row;
+    const __m256i vlower = _mm256_set1_epi8((char)params->lower);
+    const __m256i vupper = _mm256_set1_epi8((char)params->upper);
+    const __m256i zero = _mm256_setzero_si256();
+    BLEND_VALUES_AVX2;
+
+    uint32_t i = 0;
+    for (; i + 64 <= count; i += 64)
+    {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(src + i));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+        _mm256_storeu_si256((__m256i*)(dst + i), BLEND_AVX2(INSIDE_U8_AVX2(a)));
+        _mm256_storeu_si256((__m256i*)(dst + i + 32), BLEND_AVX2(INSIDE_U8_AVX2(b)));
+    }
+
+    ThresholdRowSSE2U8(src + i, dst + i, count - i, params);
+}
+
+VX_TARGET_AVX2
+static void ThresholdRowAVX2U16(const void* src_row, uint8_t* dst, uint32_t count, const ThresholdParams* params)
+{
+    const uint16_t* src = (const uint16_t*)src_row;
+    const __m256i vlower = _mm256_set1_epi16((short)params->lower);
+    const __m256i vupper = _mm256_set1_epi16((short)params->upper);
+    const __m256i zero = _mm256_setzero_si256();
+    BLEND_VALUES_AVX2;
+
+    uint32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(src + i));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(src + i + 16));
+        const __m256i mask = PACK16_AVX2(INSIDE_U16_AVX2(a), INSIDE_U16_AVX2(b));
+        _mm256_storeu_si256((__m256i*)(dst + i), BLEND_AVX2(mask));
+    }
+
+    ThresholdRowSSE2U16(src + i, dst + i, count - i, params);
+}
+
+VX_TARGET_AVX2
+static void ThresholdRowAVX2S16(const void* src_row, uint8_t* dst, uint32_t count, const ThresholdParams* params)
+{
+    const int16_t* src = (const int16_t*)src_row;
+    const __m256i vlower = _mm256_set1_epi16((short)params->lower);
+    const __m256i vupper = _mm256_set1_epi16((short)params->upper);
+    const __m256i ones = _mm256_set1_epi8(-1);
+    BLEND_VALUES_AVX2;
+
+    uint32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(src + i));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(src + i + 16));
+        const __m256i mask = PACK16_AVX2(INSIDE_S16_AVX2(a), INSIDE_S16_AVX2(b));
+        _mm256_storeu_si256((__m256i*)(dst + i), BLEND_AVX2(mask));
+    }
+
+    ThresholdRowSSE2S16(src + i, dst + i, count - i, params);
+}
+
+#endif
+
+static ThresholdRowFunc SelectThresholdRow(enum vx_df_image_e format)
+{
+#ifdef VX_ARCH_X86
+    const uint32_t features = ownGetCpuFeatures();
+    if (features & VX_CPU_FEATURE_AVX2)
+        return format == VX_DF_IMAGE_U8 ? ThresholdRowAVX2U8 : format == VX_DF_IMAGE_U16 ? ThresholdRowAVX2U16 : ThresholdRowAVX2S16;
+    if (features & VX_CPU_FEATURE_SSE2)
+        return format == VX_DF_IMAGE_U8 ? ThresholdRowSSE2U8 : format == VX_DF_IMAGE_U16 ? ThresholdRowSSE2U16 : ThresholdRowSSE2S16;
+#endif
+    return format == VX_DF_IMAGE_U8 ? ThresholdRowScalarU8 : format == VX_DF_IMAGE_U16 ? ThresholdRowScalarU16 : ThresholdRowScalarS16;
+}
+
+/*
+    Packed binary output: a block of the row is thresholded into a byte mask
+    on the stack, which stays in L1, and the mask is packed into bits with
+    movemask.
+*/
+#define THRESHOLD_BITS_BLOCK 1024
+
+typedef void (*PackMaskFunc)(const uint8_t* mask, uint8_t* bits, uint32_t count);
+
+static void PackMaskScalar(const uint8_t* mask, uint8_t* bits, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i += 8)
+    {
+        const uint32_t n = count - i < 8 ? count - i : 8;
+        uint32_t byte = 0;
+        for (uint32_t j = 0; j < n; j++)
+            byte |= (uint32_t)(mask[i + j] >> 7) << j;
+        bits[i / 8] = (uint8_t)byte;
+    }
+}
+
+#ifdef VX_ARCH_X86
+
+static void PackMaskSSE2(const uint8_t* mask, uint8_t* bits, uint32_t count)
+{
+    uint32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint16_t word = (uint16_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(mask + i)));
+        memcpy(bits + i / 8, &word, sizeof(word));
+    }
+
+    PackMaskScalar(mask + i, bits + i / 8, count - i);
+}
+
+VX_TARGET_AVX2
+static void PackMaskAVX2(const uint8_t* mask, uint8_t* bits, uint32_t count)
+{
+    uint32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const uint32_t word = (uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(mask + i)));
+        memcpy(bits + i / 8, &word, sizeof(word));
+    }
+
+    PackMaskSSE2(mask + i, bits + i / 8, count - i);
+}
+
+#endif
+
+static PackMaskFunc SelectPackMask(void)
+{
+#ifdef VX_ARCH_X86
+    const uint32_t features = ownGetCpuFeatures();
+    if (features & VX_CPU_FEATURE_AVX2)
+        return PackMaskAVX2;
+    if (features & VX_CPU_FEATURE_SSE2)
+        return PackMaskSSE2;
+#endif
+    return PackMaskScalar;
+}
+
+typedef struct
+{
+    ThresholdParams params;
+    ThresholdRowFunc row;
+    PackMaskFunc pack;
+    uint32_t pixel_size;
+} ThresholdArgs;
+
+static void ThresholdMapRow(const void* const* src, void* dst, uint32_t count, const void* data)
+{
+    const ThresholdArgs* args = (const ThresholdArgs*)data;
+    args->row(src[0], (uint8_t*)dst, count, &args->params);
+}
+
+static void ThresholdMapBits(const void* const* src, void* dst, uint32_t count, const void* data)
+{
+    const ThresholdArgs* args = (const ThresholdArgs*)data;
+    const uint8_t* src_row = (const uint8_t*)src[0];
+    uint8_t* bits = (uint8_t*)dst;
+    uint8_t mask[THRESHOLD_BITS_BLOCK];
+
+    for (uint32_t x = 0; x < count; x += THRESHOLD_BITS_BLOCK)
+    {
+        const uint32_t block = count - x < THRESHOLD_BITS_BLOCK ? count - x : THRESHOLD_BITS_BLOCK;
+        args->row(src_row + (size_t)x * args->pixel_size, mask, block, &args->params);
+        args->pack(mask, bits + x / 8, block);
+    }
+}
+
+static bool GetTypeRange(enum vx_df_image_e format, enum vx_type_e data_type, int32_t* min_value, int32_t* max_value)
+{
+    enum vx_type_e format_type;
+
+    switch (format)
+    {
+    case VX_DF_IMAGE_U8:
+        format_type = VX_TYPE_UINT8;
+        *min_value = 0;
+        *max_value = UINT8_MAX;
+        break;
+    case VX_DF_IMAGE_U16:
+        format_type = VX_TYPE_UINT16;
+        *min_value = 0;
+        *max_value = UINT16_MAX;
+        break;
+    case VX_DF_IMAGE_S16:
+        format_type = VX_TYPE_INT16;
+        *min_value = INT16_MIN;
+        *max_value = INT16_MAX;
+        break;
+    default:
+        return false;
+    }
+
+    return data_type == VX_TYPE_INVALID || data_type == format_type;
+}
 
 vx_status ref_Threshold(const vx_image src_image,
                         vx_image dst_image,
@@ -18,53 +357,53 @@ vx_status ref_Threshold(const vx_image src_image,
         return VX_ERROR_INVALID_PARAMETERS;
     }
 
-    const uint32_t src_width = src_image->width;
-    const uint32_t src_height = src_image->height;
-    const uint32_t dst_width = dst_image->width;
-    const uint32_t dst_height = dst_image->height;
+    int32_t min_value;
+    int32_t max_value;
+
+    if (!GetTypeRange(src_image->image_type, thresh->data_type, &min_value, &max_value))
+    {
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
 
-    if (src_width != dst_width || src_height != dst_height)
+    const bool packed = dst_image->image_type == VX_DF_IMAGE_U1_EXT;
+    if (!packed && dst_image->image_type != VX_DF_IMAGE_U8)
     {
         return VX_ERROR_INVALID_PARAMETERS;
     }
 
-    const uint8_t* src_data = src_image->data;
-    uint8_t* dst_data = dst_image->data;
-
-   for (uint32_t ind = 0; ind <= src_width * src_height; ++ind)
-    {
-        if (ind < src_width * src_height)
-        {
-            if (thresh->threshold_type == VX_THRESHOLD_TYPE_BINARY)
-            {
-                if (src_data[ind] > thresh->value)
-                {
-                    dst_data[ind] = 255;
-                }
-                else
-                {
-                    dst_data[ind] = 0;
-                }
-            }
-            else
-            {
-                if (src_data[ind] > thresh->upper_threshold)
-                {
-                    dst_data[ind] = 0;
-                }
-                else
-                {
-                    if (src_data[ind] < thresh->lower_threshold)
-                    {
-                        dst_data[ind] = 0;
-                    }
-                    else
-                    {
-                        dst_data[ind] = 255;
-                    }
-                }
-            }
-        }
-    }
-    return VX_SUCCESS;
+    ThresholdParams params;
+
+    if (thresh->threshold_type == VX_THRESHOLD_TYPE_BINARY)
+    {
+        params.lower = thresh->value < max_value ? thresh->value + 1 : max_value + 1;
+        params.upper = max_value;
+    }
+    else
+    {
+        params.lower = thresh->lower_threshold;
+        params.upper = thresh->upper_threshold;
+    }
+
+    params.lower = params.lower > min_value ? params.lower : min_value;
+    params.upper = params.upper < max_value ? params.upper : max_value;
+
+    // without a data type the threshold keeps the original 255/0 output; packed output is always 1/0
+    const bool typed = thresh->data_type != VX_TYPE_INVALID && !packed;
+    params.true_value = typed ? thresh->true_value : UINT8_MAX;
+    params.false_value = typed ? thresh->false_value : 0;
+
+    if (params.lower > params.upper)
+    {
+        // empty range: every row function then writes false_value
+        params.lower = 1;
+        params.upper = 0;
+    }
+
+    ThresholdArgs args;
+    args.params = params;
+    args.row = SelectThresholdRow(src_image->image_type);
+    args.pack = SelectPackMask();
+    args.pixel_size = ownGetPixelSize(src_image->image_type);
+
+    return ownMapRows(&src_image, 1, dst_image, packed ? ThresholdMapBits : ThresholdMapRow, &args);
 }